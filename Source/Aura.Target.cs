@@ -10,6 +10,9 @@ public class AuraTarget : TargetRules
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 
+		// UAuraAttributeSet and AAuraProjectileManager replicate push based
+		bWithPushModel = true;
+
 		ExtraModuleNames.AddRange( new string[] { "Aura" } );
 	}
 }
@@ -4,3 +4,6 @@
 #include "Modules/ModuleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Aura, "Aura" );
+
+DEFINE_LOG_CATEGORY(LogAuraCombat);
+DEFINE_LOG_CATEGORY(LogAuraBenchmark);
@@ -4,4 +4,14 @@
 
 #include "CoreMinimal.h"
 
-#define ECC_PROJECTILE ECollisionChannel::ECC_GameTraceChannel1
\ No newline at end of file
+#define ECC_PROJECTILE ECollisionChannel::ECC_GameTraceChannel1
+
+DECLARE_STATS_GROUP(TEXT("Aura"), STATGROUP_Aura, STATCAT_Advanced);
+
+#if UE_BUILD_SHIPPING
+DECLARE_LOG_CATEGORY_EXTERN(LogAuraCombat, Warning, Warning);
+#else
+DECLARE_LOG_CATEGORY_EXTERN(LogAuraCombat, Log, All);
+#endif
+
+DECLARE_LOG_CATEGORY_EXTERN(LogAuraBenchmark, Log, All);
@@ -1,3 +1,55 @@
 
 #include "AbilitySystem/Abilities/AuraDamageGameplayAbility.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "HAL/IConsoleManager.h"
 
+static TAutoConsoleVariable<int32> CVarAuraCombatSeedOverride(
+	TEXT("Aura.Combat.SeedOverride"),
+	0,
+	TEXT("When non zero, damage spec seeds come from a stream started with this value, so replays and benchmarks roll the same block/crit results."));
+
+int32 UAuraDamageGameplayAbility::MakeCombatSeed()
+{
+	// Solo el servidor crea specs de daño, un unico stream para todas las habilidades
+	static FRandomStream SeedStream(static_cast<int32>(FPlatformTime::Cycles()));
+	static int32 StreamOverride = 0;
+
+	const int32 SeedOverride = CVarAuraCombatSeedOverride.GetValueOnGameThread();
+	if (SeedOverride != StreamOverride)
+	{
+		StreamOverride = SeedOverride;
+		SeedStream.Initialize(SeedOverride != 0 ? SeedOverride : static_cast<int32>(FPlatformTime::Cycles()));
+	}
+
+	const uint32 Seed = SeedStream.GetUnsignedInt();
+	return Seed != 0 ? static_cast<int32>(Seed) : 1;
+}
+
+FGameplayEffectSpecHandle UAuraDamageGameplayAbility::MakeDamageEffectSpecHandle(UObject* SourceObject) const
+{
+	const UAbilitySystemComponent* SourceASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetAvatarActorFromActorInfo());
+	FGameplayEffectContextHandle ContextHandle = SourceASC->MakeEffectContext();
+	ContextHandle.SetAbility(this);
+	ContextHandle.AddSourceObject(SourceObject);
+	UAuraAbilitySystemLibrary::SetCombatSeed(ContextHandle, MakeCombatSeed());
+
+	const FGameplayEffectSpecHandle SpecHandle = SourceASC->MakeOutgoingSpec(DamageEffectClass, GetAbilityLevel(), ContextHandle);
+	for (const TTuple<FGameplayTag, FScalableFloat>& Pair : DamageTypes)
+	{
+		const float ScaledDamage = Pair.Value.GetValueAtLevel(GetAbilityLevel());
+		UAbilitySystemBlueprintLibrary::AssignTagSetByCallerMagnitude(SpecHandle, Pair.Key, ScaledDamage);
+	}
+	return SpecHandle;
+}
+
+void UAuraDamageGameplayAbility::CauseDamageToTargets(const TArray<AActor*>& TargetActors)
+{
+	// Blueprint may call this after the avatar is gone
+	AActor* AvatarActor = GetAvatarActorFromActorInfo();
+	if (AvatarActor == nullptr || !HasAuthority(&CurrentActivationInfo)) return;
+
+	const FGameplayEffectSpecHandle DamageSpecHandle = MakeDamageEffectSpecHandle(AvatarActor);
+	UAuraAbilitySystemLibrary::ApplyDamageEffectToTargets(DamageSpecHandle, TargetActors);
+}
@@ -3,6 +3,9 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
 #include "Actor/AuraProjectile.h"
+#include "Actor/AuraProjectileManager.h"
+#include "Actor/AuraProjectileManagerSubsystem.h"
+#include "Actor/AuraProjectilePoolSubsystem.h"
 #include "Interfaces/CombatInterface.h"
 #include "Aura/Public/AuraGameplayTags.h"
 
@@ -12,6 +15,14 @@ void UAuraProjectileSpell::ActivateAbility(const FGameplayAbilitySpecHandle Hand
 	const FGameplayEventData* TriggerEventData)
 {
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
+
+	if (HasAuthority(&ActivationInfo) && !bUseBatchedProjectiles)
+	{
+		if (UAuraProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UAuraProjectilePoolSubsystem>())
+		{
+			Pool->Prewarm(ProjectileClass, PoolPrewarmCount);
+		}
+	}
 }
 
 void UAuraProjectileSpell::SpawnProjectile(const FVector& ProjectileTargetLocation)
@@ -30,29 +41,32 @@ void UAuraProjectileSpell::SpawnProjectile(const FVector& ProjectileTargetLocati
 		FTransform SpawnTransform;
 		SpawnTransform.SetLocation(SocketLocation);
 		SpawnTransform.SetRotation(Rotation.Quaternion());
-		AAuraProjectile* Projectile = GetWorld()->SpawnActorDeferred<AAuraProjectile>(
+
+		if (bUseBatchedProjectiles)
+		{
+			UAuraProjectileManagerSubsystem* ManagerSubsystem = GetWorld()->GetSubsystem<UAuraProjectileManagerSubsystem>();
+			AAuraProjectileManager* ProjectileManager = ManagerSubsystem ? ManagerSubsystem->GetProjectileManager() : nullptr;
+			if (ProjectileManager)
+			{
+				ProjectileManager->SpawnProjectile(ProjectileClass, SocketLocation, Rotation.Vector(), BatchedSpreadDegrees,
+					GetAvatarActorFromActorInfo(), MakeDamageEffectSpecHandle(GetAvatarActorFromActorInfo()));
+			}
+			return;
+		}
+
+		UAuraProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UAuraProjectilePoolSubsystem>();
+		if (Pool == nullptr) return;
+
+		AAuraProjectile* Projectile = Pool->AcquireProjectile(
 			ProjectileClass,
-			SpawnTransform,
 			GetOwningActorFromActorInfo(),
-			Cast<APawn>(GetOwningActorFromActorInfo()),
-			ESpawnActorCollisionHandlingMethod::AlwaysSpawn
+			Cast<APawn>(GetOwningActorFromActorInfo())
 			);
 
-		const UAbilitySystemComponent* SourceASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetAvatarActorFromActorInfo());
-		FGameplayEffectContextHandle ContextHandle = SourceASC->MakeEffectContext();
-		ContextHandle.SetAbility(this);
-		ContextHandle.AddSourceObject(Projectile);
-		
-		const FGameplayEffectSpecHandle SpecHandle = SourceASC->MakeOutgoingSpec(DamageEffectClass, GetAbilityLevel(),ContextHandle);
-		const FAuraGameplayTags GameplayTags = FAuraGameplayTags::Get();
-
-		for (auto& Pair : DamageTypes)
+		if (Projectile)
 		{
-			const float ScaledDamage = Pair.Value.GetValueAtLevel(GetAbilityLevel());
-			UAbilitySystemBlueprintLibrary::AssignTagSetByCallerMagnitude(SpecHandle, Pair.Key, ScaledDamage);
+			Projectile->DamageEffectSpecHandle = MakeDamageEffectSpecHandle(Projectile);
+			Projectile->ActivatePooled(SpawnTransform);
 		}
-		
-		Projectile->DamageEffectSpecHandle = SpecHandle;
-		Projectile->FinishSpawning(SpawnTransform);
 	}
 }
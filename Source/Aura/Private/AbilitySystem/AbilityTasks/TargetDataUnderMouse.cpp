@@ -1,5 +1,6 @@
 #include "AbilitySystem/AbilityTasks/TargetDataUnderMouse.h"
 #include "AbilitySystemComponent.h"
+#include "PlayerController/AuraCursorTraceComponent.h"
 
 // Implementación de una tarea personalizada para obtener datos del cursor del jugador.
 
@@ -50,10 +51,16 @@ void UTargetDataUnderMouse::SendMouseCursorData()
     // Obtiene el controlador del jugador (necesario para obtener la información del cursor)
     APlayerController* PC = Ability->GetCurrentActorInfo()->PlayerController.Get();
 
-    // Declara una estructura FHitResult para almacenar la información del impacto del cursor
+    // Reutiliza la traza cacheada del controlador si la tiene, si no traza una vez
     FHitResult CursorHit;
-
-    PC->GetHitResultUnderCursor(ECC_Visibility, false, CursorHit);
+    if (const UAuraCursorTraceComponent* CursorTraceComponent = PC->FindComponentByClass<UAuraCursorTraceComponent>())
+    {
+        CursorHit = CursorTraceComponent->GetCursorHit();
+    }
+    else
+    {
+        PC->GetHitResultUnderCursor(ECC_Visibility, false, CursorHit);
+    }
 
     // Crea un objeto de datos de objetivo, que es la información del objetivo que estamos apuntando
     FGameplayAbilityTargetDataHandle DataHandle;
@@ -2,11 +2,28 @@
 
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/Abilities/AuraGameplayAbility.h"
+#include "AbilitySystem/AuraAttributeSet.h"
+#include "Aura/Aura.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attribute Snapshot Hits"), STAT_AuraAttributeSnapshotHits, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attribute Snapshot Misses"), STAT_AuraAttributeSnapshotMisses, STATGROUP_Aura);
+
+static_assert(static_cast<int32>(EAuraAttribute::Count) <= 32, "SnapshotBoundAttributes needs one bit per attribute");
+
+// Distinct source/target tag contexts kept in the attribute snapshot, in practice one per enemy type and buff combination.
+static constexpr int32 MaxAttributeSnapshots = 16;
 
 
 void UAuraAbilitySystemComponent::AbilityActorInfoSet()
 {
-	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UAuraAbilitySystemComponent::ClientEffectApplied);
+	// Solo el servidor decide que efectos llegan a la UI del cliente
+	if (!IsOwnerActorAuthoritative()) return;
+
+	if (ClientEffectTagQuery.IsEmpty())
+	{
+		ClientEffectTagQuery = FGameplayTagQuery::MakeQuery_MatchAnyTags(FGameplayTagContainer(FGameplayTag::RequestGameplayTag(FName("Message"))));
+	}
+	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UAuraAbilitySystemComponent::OnEffectAppliedToSelf);
 }
 
 void UAuraAbilitySystemComponent::AddCharacterAbilities(const TArray<TSubclassOf<UGameplayAbility>>& StartupAbilities)
@@ -32,15 +49,18 @@ void UAuraAbilitySystemComponent::AbilityInputTagHeld(const FGameplayTag& InputT
 {
 	if (!InputTag.IsValid()) return;
 
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	// Copia de las referencias, activar una habilidad puede invalidar el indice
+	for (const FInputTagSpecRef& SpecRef : GetSpecsForInputTag(InputTag))
 	{
-		if (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag))
+		if (!ActivatableAbilities.Items.IsValidIndex(SpecRef.Index)) continue;
+
+		FGameplayAbilitySpec& AbilitySpec = ActivatableAbilities.Items[SpecRef.Index];
+		if (AbilitySpec.Handle != SpecRef.Handle) continue;
+
+		AbilitySpecInputPressed(AbilitySpec);
+		if (!AbilitySpec.IsActive())
 		{
-			AbilitySpecInputPressed(AbilitySpec);
-			if (!AbilitySpec.IsActive())
-			{
-				TryActivateAbility(AbilitySpec.Handle);
-			}
+			TryActivateAbility(AbilitySpec.Handle);
 		}
 	}	
 }
@@ -49,27 +69,209 @@ void UAuraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& In
 {
 	if (!InputTag.IsValid()) return;
 
-	for (FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	for (const FInputTagSpecRef& SpecRef : GetSpecsForInputTag(InputTag))
 	{
-		if (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag))
+		if (!ActivatableAbilities.Items.IsValidIndex(SpecRef.Index)) continue;
+
+		FGameplayAbilitySpec& AbilitySpec = ActivatableAbilities.Items[SpecRef.Index];
+		if (AbilitySpec.Handle != SpecRef.Handle) continue;
+
+		AbilitySpecInputReleased(AbilitySpec);
+	}
+}
+
+void UAuraAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+	MarkInputTagIndexDirty();
+}
+
+void UAuraAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnRemoveAbility(AbilitySpec);
+	MarkInputTagIndexDirty();
+}
+
+void UAuraAbilitySystemComponent::OnRep_ActivateAbilities()
+{
+	Super::OnRep_ActivateAbilities();
+
+	// Los specs replicados pueden haber cambiado de posicion o de DynamicAbilityTags
+	MarkInputTagIndexDirty();
+}
+
+UAuraAbilitySystemComponent::FInputTagSpecRefs UAuraAbilitySystemComponent::GetSpecsForInputTag(const FGameplayTag& InputTag)
+{
+	// Spec edits like a new input tag go through MarkAbilitySpecDirty
+	if (bInputTagIndexDirty || InputTagIndexReplicationKey != ActivatableAbilities.ArrayReplicationKey)
+	{
+		RebuildInputTagIndex();
+	}
+
+	const FInputTagSpecRefs* SpecRefs = InputTagIndex.Find(InputTag);
+	if (SpecRefs == nullptr) return FInputTagSpecRefs();
+
+	for (const FInputTagSpecRef& SpecRef : *SpecRefs)
+	{
+		if (!IsInputTagSpecRefValid(SpecRef, InputTag))
+		{
+			// Cambio sin pasar por OnGiveAbility/OnRemoveAbility, reconstruimos una vez
+			RebuildInputTagIndex();
+			SpecRefs = InputTagIndex.Find(InputTag);
+			return SpecRefs ? *SpecRefs : FInputTagSpecRefs();
+		}
+	}
+	return *SpecRefs;
+}
+
+void UAuraAbilitySystemComponent::RebuildInputTagIndex()
+{
+	InputTagIndex.Reset();
+	bInputTagIndexDirty = false;
+	InputTagIndexReplicationKey = ActivatableAbilities.ArrayReplicationKey;
+
+	for (int32 Index = 0; Index < ActivatableAbilities.Items.Num(); ++Index)
+	{
+		const FGameplayAbilitySpec& AbilitySpec = ActivatableAbilities.Items[Index];
+		for (const FGameplayTag& Tag : AbilitySpec.DynamicAbilityTags)
 		{
-			AbilitySpecInputReleased(AbilitySpec);
+			InputTagIndex.FindOrAdd(Tag).Add({ Index, AbilitySpec.Handle });
 		}
 	}
 }
 
-void UAuraAbilitySystemComponent::ClientEffectApplied_Implementation(
+bool UAuraAbilitySystemComponent::IsInputTagSpecRefValid(const FInputTagSpecRef& SpecRef, const FGameplayTag& InputTag) const
+{
+	return ActivatableAbilities.Items.IsValidIndex(SpecRef.Index)
+		&& ActivatableAbilities.Items[SpecRef.Index].Handle == SpecRef.Handle
+		&& ActivatableAbilities.Items[SpecRef.Index].DynamicAbilityTags.HasTagExact(InputTag);
+}
+
+void UAuraAbilitySystemComponent::OnEffectAppliedToSelf(
 	UAbilitySystemComponent* AbilitySystemComponent,
 	const FGameplayEffectSpec& EffectSpec,
 	FActiveGameplayEffectHandle ActiveEffectHandle)
 {
-	// Creamos un contenedor para almacenar los tags del efecto
 	FGameplayTagContainer TagContainer;
-
-	// Extraemos todos los Asset Tags del GameplayEffectSpec y los almacenamos en TagContainer
 	EffectSpec.GetAllAssetTags(TagContainer);
 
-	// Disparamos un evento (broadcast) que notifica a todos los listeners subscritos
-	// pasndoles el contenedor de tags asociados al efecto aplicado
+	// Damage, regen and bookkeeping effects stop here
+	if (!ClientEffectTagQuery.Matches(TagContainer)) return;
+
+	const int32 NumPending = PendingClientEffectAssetTags.Num();
+	for (const FGameplayTag& Tag : TagContainer)
+	{
+		if (ClientEffectTagQuery.Matches(FGameplayTagContainer(Tag)))
+		{
+			PendingClientEffectAssetTags.Add(Tag);
+		}
+	}
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (PendingClientEffectAssetTags.Num() > NumPending && !TimerManager.TimerExists(FlushClientEffectAssetTagsTimer))
+	{
+		FlushClientEffectAssetTagsTimer = TimerManager.SetTimerForNextTick(this, &UAuraAbilitySystemComponent::FlushClientEffectAssetTags);
+	}
+}
+
+void UAuraAbilitySystemComponent::FlushClientEffectAssetTags()
+{
+	FlushClientEffectAssetTagsTimer.Invalidate();
+	if (PendingClientEffectAssetTags.Num() > 0)
+	{
+		ClientEffectAssetTags(PendingClientEffectAssetTags);
+		PendingClientEffectAssetTags.Reset();
+	}
+}
+
+void UAuraAbilitySystemComponent::ClientEffectAssetTags_Implementation(const TArray<FGameplayTag>& AssetTags)
+{
+	// Same container the old per effect RPC broadcast, with every tag of the frame
+	FGameplayTagContainer TagContainer;
+	for (const FGameplayTag& Tag : AssetTags)
+	{
+		TagContainer.AddTagFast(Tag);
+	}
 	EffectAssetTags.Broadcast(TagContainer);
 }
+
+UAuraAbilitySystemComponent::FAttributeSnapshot* UAuraAbilitySystemComponent::FindAttributeSnapshotContext(uint32 TagsHash, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags)
+{
+	const FGameplayTagContainer& Source = SourceTags ? *SourceTags : FGameplayTagContainer::EmptyContainer;
+	const FGameplayTagContainer& Target = TargetTags ? *TargetTags : FGameplayTagContainer::EmptyContainer;
+	for (FAttributeSnapshot& Snapshot : AttributeSnapshots)
+	{
+		// The hash only filters, equal containers are what makes the values reusable
+		if (Snapshot.TagsHash == TagsHash && Snapshot.SourceTags == Source && Snapshot.TargetTags == Target)
+		{
+			return &Snapshot;
+		}
+	}
+	return nullptr;
+}
+
+bool UAuraAbilitySystemComponent::FindAttributeSnapshot(EAuraAttribute Attribute, uint32 TagsHash, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, float& OutValue)
+{
+	if (const FAttributeSnapshot* Snapshot = FindAttributeSnapshotContext(TagsHash, SourceTags, TargetTags))
+	{
+		for (const FAttributeSnapshot::FValue& Value : Snapshot->Values)
+		{
+			if (Value.Attribute == Attribute && Value.ChangeCount == AttributeChangeCounts[static_cast<int32>(Attribute)])
+			{
+				INC_DWORD_STAT(STAT_AuraAttributeSnapshotHits);
+				OutValue = Value.Value;
+				return true;
+			}
+		}
+	}
+	INC_DWORD_STAT(STAT_AuraAttributeSnapshotMisses);
+	return false;
+}
+
+void UAuraAbilitySystemComponent::StoreAttributeSnapshot(EAuraAttribute Attribute, uint32 TagsHash, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, float Value)
+{
+	// The aggregator broadcasts on every mod change, even when the value ends up the same
+	const uint32 AttributeBit = 1u << static_cast<uint8>(Attribute);
+	if ((SnapshotBoundAttributes & AttributeBit) == 0)
+	{
+		SnapshotBoundAttributes |= AttributeBit;
+		AttributeChangeCounts.SetNumZeroed(static_cast<int32>(EAuraAttribute::Count));
+		const FGameplayAttribute& GameplayAttribute = UAuraAttributeSet::GetAttributeDescriptor(Attribute).Attribute;
+		GetGameplayAttributeValueChangeDelegate(GameplayAttribute).AddUObject(this, &UAuraAbilitySystemComponent::OnSnapshotAttributeChanged);
+	}
+
+	FAttributeSnapshot* Snapshot = FindAttributeSnapshotContext(TagsHash, SourceTags, TargetTags);
+	if (Snapshot == nullptr)
+	{
+		if (AttributeSnapshots.Num() == MaxAttributeSnapshots)
+		{
+			AttributeSnapshots.Reset();
+		}
+		Snapshot = &AttributeSnapshots.AddDefaulted_GetRef();
+		Snapshot->TagsHash = TagsHash;
+		Snapshot->SourceTags = SourceTags ? *SourceTags : FGameplayTagContainer::EmptyContainer;
+		Snapshot->TargetTags = TargetTags ? *TargetTags : FGameplayTagContainer::EmptyContainer;
+	}
+
+	const uint32 ChangeCount = AttributeChangeCounts[static_cast<int32>(Attribute)];
+	for (FAttributeSnapshot::FValue& SnapshotValue : Snapshot->Values)
+	{
+		// Stale value of the same attribute, evaluated before its last change
+		if (SnapshotValue.Attribute == Attribute)
+		{
+			SnapshotValue.ChangeCount = ChangeCount;
+			SnapshotValue.Value = Value;
+			return;
+		}
+	}
+	Snapshot->Values.Add({ Attribute, ChangeCount, Value });
+}
+
+void UAuraAbilitySystemComponent::OnSnapshotAttributeChanged(const FOnAttributeChangeData& Data)
+{
+	const EAuraAttribute Attribute = UAuraAttributeSet::FindAuraAttribute(Data.Attribute);
+	if (Attribute != EAuraAttribute::None)
+	{
+		++AttributeChangeCounts[static_cast<int32>(Attribute)];
+	}
+}
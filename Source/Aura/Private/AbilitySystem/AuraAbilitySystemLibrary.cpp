@@ -2,8 +2,11 @@
 
 #include "AbilitySystem/AuraAbilitySystemLibrary.h"
 
+#include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
 #include "AuraAbilityTypes.h"
+#include "AbilitySystem/AuraAttributeSet.h"
+#include "AbilitySystem/ExecCalc/ExecCalc_Damage.h"
 #include "Game/AuraGameModeBase.h"
 #include "Interfaces/CombatInterface.h"
 #include "Kismet/GameplayStatics.h"
@@ -141,3 +144,85 @@ void UAuraAbilitySystemLibrary::SetIsCriticalHit(FGameplayEffectContextHandle& E
 		AuraEffectContext->SetIsCriticalHit(bInIsCritical);
 	}
 }
+
+void UAuraAbilitySystemLibrary::SetCombatSeed(FGameplayEffectContextHandle& EffectContextHandle, int32 InCombatSeed)
+{
+	FAuraGameplayEffectContext* AuraEffectContext = static_cast<FAuraGameplayEffectContext*>(EffectContextHandle.Get());
+	if (AuraEffectContext)
+	{
+		AuraEffectContext->SetCombatSeed(InCombatSeed);
+	}
+}
+
+float UAuraAbilitySystemLibrary::RollCombatRandom(const FGameplayEffectContextHandle& EffectContextHandle, int32 RollIndex)
+{
+	const FAuraGameplayEffectContext* AuraEffectContext = static_cast<const FAuraGameplayEffectContext*>(EffectContextHandle.Get());
+	if (AuraEffectContext)
+	{
+		return AuraEffectContext->RollCombatRandom(RollIndex);
+	}
+	return FMath::FRand();
+}
+
+int32 UAuraAbilitySystemLibrary::GetCombatTargetIndex(const FGameplayEffectContextHandle& EffectContextHandle, const AActor* Target)
+{
+	if (!EffectContextHandle.IsValid() || Target == nullptr) return 0;
+
+	const int32 TargetIndex = EffectContextHandle.GetActors().IndexOfByPredicate([Target](const TWeakObjectPtr<AActor>& Actor)
+	{
+		return Actor.Get() == Target;
+	});
+	return TargetIndex != INDEX_NONE ? TargetIndex : 0;
+}
+
+void UAuraAbilitySystemLibrary::ApplyDamageEffectToTargets(const FGameplayEffectSpecHandle& DamageEffectSpecHandle, const TArray<AActor*>& TargetActors)
+{
+	const FGameplayEffectSpec* DamageSpec = DamageEffectSpecHandle.Data.Get();
+	if (DamageSpec == nullptr) return;
+
+	TArray<UAbilitySystemComponent*> TargetASCs;
+	TargetASCs.Reserve(TargetActors.Num());
+	for (AActor* TargetActor : TargetActors)
+	{
+		if (UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(TargetActor))
+		{
+			TargetASCs.AddUnique(TargetASC);
+		}
+	}
+
+	// Targets go into the replicated context in roll order, single executions find their index there
+	TArray<TWeakObjectPtr<AActor>> TargetAvatars;
+	TargetAvatars.Reserve(TargetASCs.Num());
+	for (const UAbilitySystemComponent* TargetASC : TargetASCs)
+	{
+		TargetAvatars.Add(TargetASC->GetAvatarActor());
+	}
+	FGameplayEffectContextHandle ContextHandle = DamageSpec->GetContext();
+	ContextHandle.AddActors(TargetAvatars, true);
+
+	if (!UExecCalc_Damage::SupportsDamageBatch(*DamageSpec))
+	{
+		for (UAbilitySystemComponent* TargetASC : TargetASCs)
+		{
+			TargetASC->ApplyGameplayEffectSpecToSelf(*DamageSpec);
+		}
+		return;
+	}
+
+	FAuraDamageBatch Batch;
+	// Without source data nothing is applied, instead of 0 damage to every target
+	if (!UExecCalc_Damage::CalculateDamageBatch(*DamageSpec, TargetASCs, Batch)) return;
+
+	// The spec only carries this damage, commit it straight to each target's attribute set instead of applying the effect.
+	for (int32 Index = 0; Index < Batch.Num(); ++Index)
+	{
+		for (UAttributeSet* AttributeSet : Batch.TargetASCs[Index]->GetSpawnedAttributes())
+		{
+			if (UAuraAttributeSet* AuraAttributeSet = Cast<UAuraAttributeSet>(AttributeSet))
+			{
+				AuraAttributeSet->ApplyMitigatedDamage(Batch.Damage[Index], DamageSpec->GetContext(), Batch.bIsBlockedHit[Index], Batch.bIsCriticalHit[Index]);
+				break;
+			}
+		}
+	}
+}
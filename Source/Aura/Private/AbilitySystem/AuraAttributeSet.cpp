@@ -9,92 +9,177 @@
 #include "Interfaces/CombatInterface.h"
 #include "Kismet/GameplayStatics.h"
 #include "PlayerController/AuraPlayerController.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Aura/Aura.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attribute Replication Dirty Marks"), STAT_AuraAttributeDirtyMarks, STATGROUP_Aura);
+
+
+namespace AuraAttributeRegistry
+{
+	struct FRegistry
+	{
+		FAuraAttributeDescriptor Descriptors[static_cast<int32>(EAuraAttribute::Count)];
+
+		// EAuraAttribute by property offset in UAuraAttributeSet, in steps of the FGameplayAttributeData alignment.
+		// Members in between (IncomingDamage) map to None.
+		TArray<EAuraAttribute> AttributesByOffset;
+		int32 MinOffset = 0;
+
+		FRegistry()
+		{
+#define AURA_ATTRIBUTE_DESCRIPTOR(Name, InTagMember, InRepCondition, InClampMax) \
+			{ \
+				FAuraAttributeDescriptor& Descriptor = Descriptors[static_cast<int32>(EAuraAttribute::Name)]; \
+				Descriptor.Attribute = UAuraAttributeSet::Get##Name##Attribute(); \
+				Descriptor.TagMember = InTagMember; \
+				Descriptor.RepCondition = InRepCondition; \
+				Descriptor.ClampMax = EAuraAttribute::InClampMax; \
+			}
+			AURA_ATTRIBUTES(AURA_ATTRIBUTE_DESCRIPTOR)
+#undef AURA_ATTRIBUTE_DESCRIPTOR
+
+			MinOffset = MAX_int32;
+			int32 MaxOffset = 0;
+			for (const FAuraAttributeDescriptor& Descriptor : Descriptors)
+			{
+				const int32 Offset = Descriptor.Attribute.GetUProperty()->GetOffset_ForInternal();
+				MinOffset = FMath::Min(MinOffset, Offset);
+				MaxOffset = FMath::Max(MaxOffset, Offset);
+			}
+
+			AttributesByOffset.Init(EAuraAttribute::None, GetSlot(MaxOffset) + 1);
+			for (int32 Index = 0; Index < static_cast<int32>(EAuraAttribute::Count); ++Index)
+			{
+				const int32 Slot = GetSlot(Descriptors[Index].Attribute.GetUProperty()->GetOffset_ForInternal());
+				check(AttributesByOffset[Slot] == EAuraAttribute::None);
+				AttributesByOffset[Slot] = static_cast<EAuraAttribute>(Index);
+			}
+		}
+
+		int32 GetSlot(int32 Offset) const
+		{
+			return (Offset - MinOffset) / static_cast<int32>(alignof(FGameplayAttributeData));
+		}
+	};
+
+	static const FRegistry& Get()
+	{
+		static const FRegistry Registry;
+		return Registry;
+	}
+}
 
 UAuraAttributeSet::UAuraAttributeSet()
 {
-	const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
-	
-	TagsToAttribute.Add(GameplayTags.Attribute_Primary_Strength, GetStrengthAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Primary_Intelligence, GetIntelligenceAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Primary_Resilience, GetResilienceAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Primary_Vigor, GetVigorAttribute);
-
-	TagsToAttribute.Add(GameplayTags.Attribute_Secondary_Armor, GetArmorAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Secondary_ArmorPenetration, GetArmorPenetrationAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Secondary_BlockChance, GetBlockChanceAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Secondary_CriticalHitChance, GetCriticalHitChanceAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Secondary_CriticalHitDamage, GetCriticalHitDamageAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Secondary_CriticalHitResistance, GetCriticalHitResistanceAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Secondary_HealthRegeneration, GetHealthRegenerationAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Secondary_ManaRegeneration, GetManaRegenerationAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Secondary_MaxHealth, GetMaxHealthAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Secondary_MaxMana, GetMaxManaAttribute);
-
-	TagsToAttribute.Add(GameplayTags.Attribute_Resistance_Fire, GetFireResistanceAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Resistance_Arcane, GetArcaneResistanceAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Resistance_Lightning, GetLightningResistanceAttribute);
-	TagsToAttribute.Add(GameplayTags.Attribute_Resistance_Physical, GetPhysicalResistanceAttribute);
+}
+
+TConstArrayView<FAuraAttributeDescriptor> UAuraAttributeSet::GetAttributeDescriptors()
+{
+	return MakeArrayView(AuraAttributeRegistry::Get().Descriptors);
+}
+
+EAuraAttribute UAuraAttributeSet::FindAuraAttribute(const FGameplayAttribute& Attribute)
+{
+	const FProperty* Property = Attribute.GetUProperty();
+	if (Property == nullptr || Property->GetOwnerClass() != UAuraAttributeSet::StaticClass()) return EAuraAttribute::None;
+
+	const AuraAttributeRegistry::FRegistry& Registry = AuraAttributeRegistry::Get();
+	const int32 Slot = Registry.GetSlot(Property->GetOffset_ForInternal());
+	return Registry.AttributesByOffset.IsValidIndex(Slot) ? Registry.AttributesByOffset[Slot] : EAuraAttribute::None;
 }
 
 void UAuraAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Health, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, MaxHealth, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Mana, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, MaxMana, COND_None, REPNOTIFY_Always);
-
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Strength, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Intelligence, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Resilience, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Vigor, COND_None, REPNOTIFY_Always);
-
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, Armor, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, ArmorPenetration, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, BlockChance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, CriticalHitChance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, CriticalHitDamage, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, CriticalHitResistance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, HealthRegeneration, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, ManaRegeneration, COND_None, REPNOTIFY_Always);
-
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, FireResistance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, ArcaneResistance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, LightningResistance, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UAuraAttributeSet, PhysicalResistance, COND_None, REPNOTIFY_Always);
-	
-	
+
+	FDoRepLifetimeParams Params;
+	Params.RepNotifyCondition = REPNOTIFY_Always;
+	Params.bIsPushBased = true;
+#define AURA_ATTRIBUTE_DOREPLIFETIME(Name, TagMember, RepCondition, ClampMax) \
+	Params.Condition = GetAttributeDescriptor(EAuraAttribute::Name).RepCondition; \
+	DOREPLIFETIME_WITH_PARAMS(UAuraAttributeSet, Name, Params);
+	AURA_ATTRIBUTES(AURA_ATTRIBUTE_DOREPLIFETIME)
+#undef AURA_ATTRIBUTE_DOREPLIFETIME
+}
+
+void UAuraAttributeSet::SetVitalsReplicatedToAll(bool bReplicatedToAll)
+{
+	const ELifetimeCondition Condition = bReplicatedToAll ? COND_None : COND_OwnerOnly;
+#define AURA_ATTRIBUTE_SET_DYNAMIC_CONDITION(Name, TagMember, RepCondition, ClampMax) \
+	if (RepCondition == COND_Dynamic) \
+	{ \
+		DOREPDYNAMICCONDITION_SETCONDITION_FAST(UAuraAttributeSet, Name, Condition); \
+	}
+	AURA_ATTRIBUTES(AURA_ATTRIBUTE_SET_DYNAMIC_CONDITION)
+#undef AURA_ATTRIBUTE_SET_DYNAMIC_CONDITION
+}
+
+bool UAuraAttributeSet::ClampAttributeValue(EAuraAttribute AuraAttribute, float& NewValue) const
+{
+	if (AuraAttribute == EAuraAttribute::None) return false;
+
+	const EAuraAttribute ClampMax = GetAttributeDescriptor(AuraAttribute).ClampMax;
+	if (ClampMax == EAuraAttribute::None) return false;
+
+	NewValue = FMath::Clamp(NewValue, 0.f, GetAttributeDescriptor(ClampMax).Attribute.GetNumericValue(this));
+	return true;
 }
 
 void UAuraAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
 {
 	Super::PreAttributeChange(Attribute, NewValue);
 
-	if (Attribute == GetHealthAttribute())
+	ClampAttributeValue(FindAuraAttribute(Attribute), NewValue);
+}
+
+void UAuraAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+	if (OldValue != NewValue)
 	{
-		NewValue = FMath::Clamp(NewValue, 0.f, GetMaxHealth());
+		MarkAttributeReplicationDirty(FindAuraAttribute(Attribute));
 	}
-	if (Attribute == GetManaAttribute())
+}
+
+void UAuraAttributeSet::PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const
+{
+	Super::PostAttributeBaseChange(Attribute, OldValue, NewValue);
+
+	if (OldValue != NewValue)
 	{
-		NewValue = FMath::Clamp(NewValue, 0.f, GetMaxMana());
+		MarkAttributeReplicationDirty(FindAuraAttribute(Attribute));
 	}
 }
 
+void UAuraAttributeSet::MarkAttributeReplicationDirty(EAuraAttribute AuraAttribute) const
+{
+	switch (AuraAttribute)
+	{
+#define AURA_ATTRIBUTE_MARK_DIRTY(Name, TagMember, RepCondition, ClampMax) \
+	case EAuraAttribute::Name: \
+		MARK_PROPERTY_DIRTY_FROM_NAME(UAuraAttributeSet, Name, this); \
+		break;
+	AURA_ATTRIBUTES(AURA_ATTRIBUTE_MARK_DIRTY)
+#undef AURA_ATTRIBUTE_MARK_DIRTY
+	default:
+		// Meta attributes (IncomingDamage) don't replicate.
+		return;
+	}
+	INC_DWORD_STAT(STAT_AuraAttributeDirtyMarks);
+}
+
 void UAuraAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
 	Super::PostGameplayEffectExecute(Data);
 	FEffectProperties Props;
 	SetEffectProperties(Data, Props);
 
-	if (Data.EvaluatedData.Attribute == GetHealthAttribute())
-	{
-		SetHealth(FMath::Clamp(GetHealth(), 0.f, GetMaxHealth()));
-		//UE_LOG(LogTemp, Warning, TEXT("Change health on %s, health: %f"), *Props.TargetAvatarActor->GetName(), GetHealth());
-	}
-	if (Data.EvaluatedData.Attribute == GetManaAttribute())
+	float ClampedValue = Data.EvaluatedData.Attribute.GetNumericValue(this);
+	if (ClampAttributeValue(FindAuraAttribute(Data.EvaluatedData.Attribute), ClampedValue))
 	{
-		SetMana(FMath::Clamp(GetMana(), 0.f, GetMaxMana()));
+		GetOwningAbilitySystemComponentChecked()->SetNumericAttributeBase(Data.EvaluatedData.Attribute, ClampedValue);
 	}
 
 	if (Data.EvaluatedData.Attribute == GetIncomingDamageAttribute())
@@ -102,37 +187,53 @@ void UAuraAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallba
 		const float LocalIncomingDamage = GetIncomingDamage();
 		SetIncomingDamage(0.f);
 
-		if (LocalIncomingDamage >= 0.f)
+		const bool bBlockHit = UAuraAbilitySystemLibrary::IsBlockedHit(Props.SourceEffectContextHandle);
+		const bool bCriticalHit = UAuraAbilitySystemLibrary::IsCriticalHit(Props.SourceEffectContextHandle);
+		HandleIncomingDamage(Props, LocalIncomingDamage, bBlockHit, bCriticalHit);
+	}
+}
+
+void UAuraAttributeSet::ApplyMitigatedDamage(float Damage, const FGameplayEffectContextHandle& SourceEffectContextHandle, bool bIsBlockedHit, bool bIsCriticalHit)
+{
+	FEffectProperties Props;
+	SetEffectProperties(SourceEffectContextHandle, *GetOwningAbilitySystemComponentChecked(), Props);
+	HandleIncomingDamage(Props, Damage, bIsBlockedHit, bIsCriticalHit);
+}
+
+void UAuraAttributeSet::HandleIncomingDamage(const FEffectProperties& Props, float Damage, bool bIsBlockedHit, bool bIsCriticalHit)
+{
+	if (Damage < 0.f) return;
+
+	const float NewHealth = GetHealth() - Damage;
+	SetHealth(FMath::Clamp(NewHealth, 0.f, GetMaxHealth()));
+	const bool bFatal = NewHealth <= 0.f;
+	if (bFatal)
+	{
+		ICombatInterface* CombatInterface = Cast<ICombatInterface>(Props.TargetAvatarActor);
+		if (CombatInterface)
 		{
-			const float NewHealth = GetHealth() - LocalIncomingDamage;
-			SetHealth(FMath::Clamp(NewHealth, 0.f, GetMaxHealth()));
-			const bool bFatal = NewHealth <= 0.f;
-			if (bFatal)
-			{
-				ICombatInterface* CombatInterface = Cast<ICombatInterface>(Props.TargetAvatarActor);
-				if (CombatInterface)
-				{
-					CombatInterface->Die();
-				}
-			}
-			else
-			{
-				FGameplayTagContainer TagContainer;
-				TagContainer.AddTag(FAuraGameplayTags::Get().Effects_HitReact);
-				Props.TargetASC->TryActivateAbilitiesByTag(TagContainer);
-			}
-			
-			const bool bBlockHit = UAuraAbilitySystemLibrary::IsBlockedHit(Props.SourceEffectContextHandle);
-			const bool bCriticalHit = UAuraAbilitySystemLibrary::IsCriticalHit(Props.SourceEffectContextHandle);
-			ShowFloatingText(Props, LocalIncomingDamage, bBlockHit, bCriticalHit);
+			CombatInterface->Die();
 		}
 	}
+	else if (Props.TargetASC)
+	{
+		FGameplayTagContainer TagContainer;
+		TagContainer.AddTag(FAuraGameplayTags::Get().Effects_HitReact);
+		Props.TargetASC->TryActivateAbilitiesByTag(TagContainer);
+	}
+
+	ShowFloatingText(Props, Damage, bIsBlockedHit, bIsCriticalHit);
 }
 
 void UAuraAttributeSet::SetEffectProperties(const FGameplayEffectModCallbackData& Data, FEffectProperties& Props) const
+{
+	SetEffectProperties(Data.EffectSpec.GetContext(), Data.Target, Props);
+}
+
+void UAuraAttributeSet::SetEffectProperties(const FGameplayEffectContextHandle& SourceEffectContextHandle, UAbilitySystemComponent& TargetASC, FEffectProperties& Props) const
 {
 	//source = causer of the effect, target = targetof the effect (owner of this attributeset)
-	Props.SourceEffectContextHandle = Data.EffectSpec.GetContext();
+	Props.SourceEffectContextHandle = SourceEffectContextHandle;
 	Props.SourceASC = Props.SourceEffectContextHandle.GetOriginalInstigatorAbilitySystemComponent();
 	if (IsValid(Props.SourceASC) && Props.SourceASC->AbilityActorInfo.IsValid() && Props.SourceASC->AbilityActorInfo->AvatarActor.IsValid())
 	{
@@ -150,10 +251,10 @@ void UAuraAttributeSet::SetEffectProperties(const FGameplayEffectModCallbackData
 			Props.SourceCharacter = Cast<ACharacter>(Props.SourceController->GetPawn());
 		}
 	}
-	if (Data.Target.AbilityActorInfo.IsValid() && Data.Target.AbilityActorInfo->AvatarActor.Get())
+	if (TargetASC.AbilityActorInfo.IsValid() && TargetASC.AbilityActorInfo->AvatarActor.Get())
 	{
-		Props.TargetAvatarActor = Data.Target.AbilityActorInfo->AvatarActor.Get();
-		Props.TargetController = Data.Target.AbilityActorInfo->PlayerController.Get();
+		Props.TargetAvatarActor = TargetASC.AbilityActorInfo->AvatarActor.Get();
+		Props.TargetController = TargetASC.AbilityActorInfo->PlayerController.Get();
 		Props.TargetCharacter = Cast<ACharacter>(Props.TargetAvatarActor);
 		Props.TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Props.TargetAvatarActor);
 	}
@@ -170,102 +271,10 @@ void UAuraAttributeSet::ShowFloatingText(const FEffectProperties& Props, const f
 	}
 }
 
-void UAuraAttributeSet::OnRep_Health(const FGameplayAttributeData& OldHealth) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, Health, OldHealth);
-}
-
-void UAuraAttributeSet::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, MaxHealth, OldMaxHealth);
-}
-
-void UAuraAttributeSet::OnRep_Mana(const FGameplayAttributeData& OldMana) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, Mana, OldMana);
-}
-
-void UAuraAttributeSet::OnRep_MaxMana(const FGameplayAttributeData& OldMaxMana) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, MaxMana, OldMaxMana);
-}
-
-void UAuraAttributeSet::OnRep_Strength(const FGameplayAttributeData& OldStrength) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, Strength, OldStrength);
-}
-
-void UAuraAttributeSet::OnRep_Intelligence(const FGameplayAttributeData& OldIntelligence) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, Intelligence, OldIntelligence);
-}
-
-void UAuraAttributeSet::OnRep_Resilience(const FGameplayAttributeData& OldResilience) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, Resilience, OldResilience);
-}
-
-void UAuraAttributeSet::OnRep_Vigor(const FGameplayAttributeData& OldVigor) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, Vigor, OldVigor);
-}
-
-void UAuraAttributeSet::OnRep_Armor(const FGameplayAttributeData& OldArmor) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, Armor, OldArmor);
-}
-
-void UAuraAttributeSet::OnRep_ArmorPenetration(const FGameplayAttributeData& OldArmorPenetration) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, ArmorPenetration, OldArmorPenetration);
-}
-
-void UAuraAttributeSet::OnRep_BlockChance(const FGameplayAttributeData& OldBlockChance) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, BlockChance, OldBlockChance);
-}
-
-void UAuraAttributeSet::OnRep_CriticalHitChance(const FGameplayAttributeData& OldCriticalHitChance) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, CriticalHitChance, OldCriticalHitChance);
-}
-
-void UAuraAttributeSet::OnRep_CriticalHitDamage(const FGameplayAttributeData& OldCriticalHitDamage) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, CriticalHitDamage, OldCriticalHitDamage);
-}
-
-void UAuraAttributeSet::OnRep_CriticalHitResistance(const FGameplayAttributeData& OldCriticalHitResistance) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, CriticalHitResistance, OldCriticalHitResistance);
-}
-
-void UAuraAttributeSet::OnRep_HealthRegeneration(const FGameplayAttributeData& OldHealthRegeneration) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, HealthRegeneration, OldHealthRegeneration);
-}
-
-void UAuraAttributeSet::OnRep_ManaRegeneration(const FGameplayAttributeData& OldManaRegeneration) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, ManaRegeneration, OldManaRegeneration);
-}
-
-void UAuraAttributeSet::OnRep_FireResistance(const FGameplayAttributeData& OldFireResistance) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, FireResistance, OldFireResistance);
-}
-
-void UAuraAttributeSet::OnRep_ArcaneResistance(const FGameplayAttributeData& OldArcaneResistance) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, ArcaneResistance, OldArcaneResistance);
-}
-
-void UAuraAttributeSet::OnRep_LightningResistance(const FGameplayAttributeData& OldLightningResistance) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, LightningResistance, OldLightningResistance);
-}
-
-void UAuraAttributeSet::OnRep_PhysicalResistance(const FGameplayAttributeData& OldPhysicalResistance) const
-{
-	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, PhysicalResistance, OldPhysicalResistance);
+#define AURA_ATTRIBUTE_ONREP(Name, TagMember, RepCondition, ClampMax) \
+void UAuraAttributeSet::OnRep_##Name(const FGameplayAttributeData& Old##Name) const \
+{ \
+	GAMEPLAYATTRIBUTE_REPNOTIFY(UAuraAttributeSet, Name, Old##Name); \
 }
+AURA_ATTRIBUTES(AURA_ATTRIBUTE_ONREP)
+#undef AURA_ATTRIBUTE_ONREP
@@ -0,0 +1,100 @@
+
+#include "AbilitySystem/AuraCombatTrace.h"
+
+#if AURA_COMBAT_TRACE
+
+#include "Aura/Aura.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<bool> CVarAuraCombatTrace(
+	TEXT("Aura.Combat.Trace"),
+	false,
+	TEXT("Records every damage execution into the combat trace ring buffer."));
+
+static TAutoConsoleVariable<int32> CVarAuraCombatTraceCapacity(
+	TEXT("Aura.Combat.TraceCapacity"),
+	4096,
+	TEXT("Number of damage executions kept by the combat trace ring buffer."));
+
+static FAutoConsoleCommand CmdAuraCombatDumpTrace(
+	TEXT("Aura.Combat.DumpTrace"),
+	TEXT("Writes the combat trace ring buffer to Saved/CombatTrace. Optional argument: file name."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString Filename = Args.Num() > 0 ? Args[0] : FString::Printf(TEXT("CombatTrace-%s.bin"), *FDateTime::Now().ToString());
+		FAuraCombatTrace::Dump(FPaths::ProjectSavedDir() / TEXT("CombatTrace") / Filename);
+	}));
+
+// Bump whenever the file layout written by Dump changes.
+static constexpr uint32 CombatTraceFileVersion = 1;
+
+TArray<FAuraCombatTraceRecord> FAuraCombatTrace::Records;
+int32 FAuraCombatTrace::NextRecordIndex = 0;
+int32 FAuraCombatTrace::Capacity = 0;
+
+bool FAuraCombatTrace::IsEnabled()
+{
+	return CVarAuraCombatTrace.GetValueOnGameThread();
+}
+
+void FAuraCombatTrace::Record(const FAuraCombatTraceRecord& Record)
+{
+	const int32 RequestedCapacity = FMath::Max(CVarAuraCombatTraceCapacity.GetValueOnGameThread(), 1);
+	if (Capacity != RequestedCapacity)
+	{
+		Capacity = RequestedCapacity;
+		Records.Empty(Capacity);
+		NextRecordIndex = 0;
+	}
+
+	if (Records.Num() < Capacity)
+	{
+		Records.Add(Record);
+	}
+	else
+	{
+		Records[NextRecordIndex] = Record;
+	}
+	NextRecordIndex = (NextRecordIndex + 1) % Capacity;
+}
+
+bool FAuraCombatTrace::Dump(const FString& Filename)
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Ar)
+	{
+		UE_LOG(LogAuraCombat, Error, TEXT("cant write combat trace to [%s]."), *Filename);
+		return false;
+	}
+
+	uint32 Version = CombatTraceFileVersion;
+	int32 NumRecords = Records.Num();
+	int32 MaxDamageTypes = FAuraCombatTraceRecord::MaxDamageTypes;
+	*Ar << Version << NumRecords << MaxDamageTypes;
+
+	// Once the buffer has wrapped, the oldest record is the next one to be overwritten.
+	const int32 FirstIndex = Records.Num() < Capacity ? 0 : NextRecordIndex;
+	for (int32 Offset = 0; Offset < Records.Num(); ++Offset)
+	{
+		FAuraCombatTraceRecord& Record = Records[(FirstIndex + Offset) % Records.Num()];
+
+		FString SourceName = GetNameSafe(Record.Source.Get());
+		FString TargetName = GetNameSafe(Record.Target.Get());
+		uint8 Flags = (Record.bIsBlockedHit ? 1 : 0) | (Record.bIsCriticalHit ? 2 : 0);
+
+		*Ar << Record.FrameNumber << SourceName << TargetName;
+		for (float& DamageTypeValue : Record.DamageByType)
+		{
+			*Ar << DamageTypeValue;
+		}
+		*Ar << Record.FinalDamage << Flags;
+	}
+
+	const bool bSuccess = Ar->Close();
+	UE_LOG(LogAuraCombat, Log, TEXT("Dumped %d combat trace records to [%s]."), NumRecords, *Filename);
+	return bSuccess;
+}
+
+#endif
@@ -1,14 +1,17 @@
 
 #include "AbilitySystem/Data/AttributeInfoDataAsset.h"
 
-FAuraAttributeInfo UAttributeInfoDataAsset::FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound) const
+const FAuraAttributeInfo& UAttributeInfoDataAsset::FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound) const
 {
-	for (const FAuraAttributeInfo& Info : AttributeInformation)
+	// Assets created at runtime never go through PostLoad.
+	if (AttributeInfoIndex.Num() == 0 && AttributeInformation.Num() > 0)
 	{
-		if (Info.AttributeTag.MatchesTagExact(AttributeTag))
-		{
-			return Info;
-		}
+		BuildAttributeInfoIndex();
+	}
+
+	if (const int32* Index = AttributeInfoIndex.Find(AttributeTag))
+	{
+		return AttributeInformation[*Index];
 	}
 
 	if (bLogNotFound)
@@ -16,5 +19,38 @@ FAuraAttributeInfo UAttributeInfoDataAsset::FindAttributeInfoForTag(const FGamep
 		UE_LOG(LogTemp, Error, TEXT("cant find info for attribute tag [%s] on attributeinfo [%s]."), *AttributeTag.ToString(), *GetNameSafe(this));
 	}
 
-	return FAuraAttributeInfo();
+	static const FAuraAttributeInfo NotFoundInfo;
+	return NotFoundInfo;
+}
+
+void UAttributeInfoDataAsset::PostLoad()
+{
+	Super::PostLoad();
+	BuildAttributeInfoIndex();
+}
+
+#if WITH_EDITOR
+void UAttributeInfoDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAttributeInfoDataAsset, AttributeInformation))
+	{
+		BuildAttributeInfoIndex();
+	}
+}
+#endif
+
+void UAttributeInfoDataAsset::BuildAttributeInfoIndex() const
+{
+	AttributeInfoIndex.Reset();
+	AttributeInfoIndex.Reserve(AttributeInformation.Num());
+	for (int32 Index = 0; Index < AttributeInformation.Num(); ++Index)
+	{
+		// Like the old linear scan, the first entry for a tag wins.
+		if (!AttributeInfoIndex.Contains(AttributeInformation[Index].AttributeTag))
+		{
+			AttributeInfoIndex.Add(AttributeInformation[Index].AttributeTag, Index);
+		}
+	}
 }
@@ -0,0 +1,44 @@
+
+#include "AbilitySystem/Data/AuraDamageCoefficientSubsystem.h"
+#include "AbilitySystem/Data/CharacterClassInfo.h"
+#include "Game/AuraGameModeBase.h"
+
+const FAuraDamageCoefficients* UAuraDamageCoefficientSubsystem::FindDamageCoefficients(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	UAuraDamageCoefficientSubsystem* Subsystem = World ? World->GetSubsystem<UAuraDamageCoefficientSubsystem>() : nullptr;
+	if (Subsystem == nullptr) return nullptr;
+
+	const UCharacterClassInfo* ClassInfo = Subsystem->GetCharacterClassInfo();
+	return ClassInfo ? &ClassInfo->GetDamageCoefficients() : nullptr;
+}
+
+void UAuraDamageCoefficientSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	GetCharacterClassInfo();
+}
+
+void UAuraDamageCoefficientSubsystem::Deinitialize()
+{
+	CharacterClassInfo = nullptr;
+	Super::Deinitialize();
+}
+
+bool UAuraDamageCoefficientSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+const UCharacterClassInfo* UAuraDamageCoefficientSubsystem::GetCharacterClassInfo()
+{
+	// Only the server has a game mode, executions before BeginPlay resolve it here
+	if (CharacterClassInfo == nullptr)
+	{
+		if (const AAuraGameModeBase* AuraGameMode = Cast<AAuraGameModeBase>(GetWorld()->GetAuthGameMode()))
+		{
+			CharacterClassInfo = AuraGameMode->CharacterClassInfo;
+		}
+	}
+	return CharacterClassInfo;
+}
@@ -1,7 +1,111 @@
 
 #include "AbilitySystem/Data/CharacterClassInfo.h"
+#include "Engine/CurveTable.h"
+#include "Aura/Aura.h"
+
+namespace AuraDamageCoefficients
+{
+	static void BakeCurve(const UCurveTable* CurveTable, const FName CurveName, TArray<float>& OutValues)
+	{
+		const FRealCurve* Curve = CurveTable->FindCurve(CurveName, FString());
+		if (Curve == nullptr)
+		{
+			UE_LOG(LogAuraCombat, Error, TEXT("cant find curve [%s] on damage coefficients [%s]."), *CurveName.ToString(), *GetNameSafe(CurveTable));
+			return;
+		}
+
+		float MinLevel = 0.f;
+		float MaxLevel = 0.f;
+		Curve->GetTimeRange(MinLevel, MaxLevel);
+
+		const int32 NumLevels = FMath::Max(FMath::CeilToInt32(MaxLevel), 0) + 1;
+		OutValues.SetNumUninitialized(NumLevels);
+		for (int32 Level = 0; Level < NumLevels; ++Level)
+		{
+			OutValues[Level] = Curve->Eval(Level);
+		}
+	}
+}
 
 FCharacterClassDefaultInfo UCharacterClassInfo::GetClassDefaultInfo(ECharacterClass CharacterClass)
 {
 	return CharacterClassInformation.FindChecked(CharacterClass);
 }
+
+const FAuraDamageCoefficients& UCharacterClassInfo::GetDamageCoefficients() const
+{
+	if (bDamageCoefficientsDirty)
+	{
+		BakeDamageCoefficients();
+	}
+	return DamageCoefficients;
+}
+
+void UCharacterClassInfo::PostLoad()
+{
+	Super::PostLoad();
+	if (DamageCalculationCoefficients)
+	{
+		DamageCalculationCoefficients->ConditionalPostLoad();
+	}
+	BindCurveTableChanged();
+	BakeDamageCoefficients();
+}
+
+void UCharacterClassInfo::BeginDestroy()
+{
+	UnbindCurveTableChanged();
+	Super::BeginDestroy();
+}
+
+#if WITH_EDITOR
+void UCharacterClassInfo::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UCharacterClassInfo, DamageCalculationCoefficients))
+	{
+		BindCurveTableChanged();
+		InvalidateDamageCoefficients();
+	}
+}
+#endif
+
+void UCharacterClassInfo::BakeDamageCoefficients() const
+{
+	DamageCoefficients.Reset();
+	bDamageCoefficientsDirty = false;
+
+	if (DamageCalculationCoefficients == nullptr) return;
+
+	AuraDamageCoefficients::BakeCurve(DamageCalculationCoefficients, FName("ArmorPenetration"), DamageCoefficients.ArmorPenetration);
+	AuraDamageCoefficients::BakeCurve(DamageCalculationCoefficients, FName("EffectiveArmor"), DamageCoefficients.EffectiveArmor);
+	AuraDamageCoefficients::BakeCurve(DamageCalculationCoefficients, FName("CriticalHitResistance"), DamageCoefficients.CriticalHitResistance);
+}
+
+void UCharacterClassInfo::InvalidateDamageCoefficients()
+{
+	bDamageCoefficientsDirty = true;
+}
+
+void UCharacterClassInfo::BindCurveTableChanged()
+{
+	if (BoundCurveTable.Get() == DamageCalculationCoefficients && CurveTableChangedHandle.IsValid()) return;
+
+	UnbindCurveTableChanged();
+	if (DamageCalculationCoefficients)
+	{
+		CurveTableChangedHandle = DamageCalculationCoefficients->OnCurveTableChanged().AddUObject(this, &UCharacterClassInfo::InvalidateDamageCoefficients);
+		BoundCurveTable = DamageCalculationCoefficients;
+	}
+}
+
+void UCharacterClassInfo::UnbindCurveTableChanged()
+{
+	if (UCurveTable* CurveTable = BoundCurveTable.Get())
+	{
+		CurveTable->OnCurveTableChanged().Remove(CurveTableChangedHandle);
+	}
+	BoundCurveTable.Reset();
+	CurveTableChangedHandle.Reset();
+}
@@ -3,55 +3,96 @@
 #include "AbilitySystemComponent.h"
 #include "AuraAbilityTypes.h"
 #include "AuraGameplayTags.h"
+#include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/AuraAbilitySystemLibrary.h"
 #include "AbilitySystem/AuraAttributeSet.h"
+#include "AbilitySystem/Data/AuraDamageCoefficientSubsystem.h"
 #include "AbilitySystem/Data/CharacterClassInfo.h"
 #include "Interfaces/CombatInterface.h"
+#include "Aura/Aura.h"
+#include "AbilitySystem/AuraCombatTrace.h"
+#include "HAL/IConsoleManager.h"
+#include "GameFramework/GameStateBase.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Execution"), STAT_AuraDamageExecution, STATGROUP_Aura);
+DECLARE_CYCLE_STAT(TEXT("Damage Batch Calculation"), STAT_AuraDamageBatch, STATGROUP_Aura);
+
+static TAutoConsoleVariable<bool> CVarAuraDamageTargetSnapshot(
+	TEXT("Aura.Damage.TargetSnapshot"),
+	true,
+	TEXT("Reuse target attributes evaluated earlier in the frame by other damage executions against the same target."));
 
 struct AuraDamageStatics
 {
-	DECLARE_ATTRIBUTE_CAPTUREDEF(Armor)
-	DECLARE_ATTRIBUTE_CAPTUREDEF(BlockChance)
-	DECLARE_ATTRIBUTE_CAPTUREDEF(ArmorPenetration)
-	DECLARE_ATTRIBUTE_CAPTUREDEF(CriticalHitChance)
-	DECLARE_ATTRIBUTE_CAPTUREDEF(CriticalHitDamage)
-	DECLARE_ATTRIBUTE_CAPTUREDEF(CriticalHitResistance)
-	DECLARE_ATTRIBUTE_CAPTUREDEF(FireResistance)
-	DECLARE_ATTRIBUTE_CAPTUREDEF(LightningResistance)
-	DECLARE_ATTRIBUTE_CAPTUREDEF(ArcaneResistance)
-	DECLARE_ATTRIBUTE_CAPTUREDEF(PhysicalResistance)
-
-
-	TMap<FGameplayTag, FGameplayEffectAttributeCaptureDefinition> TagsToCaptureDefs;
-	
+	struct FCapturedAttribute
+	{
+		EAuraAttribute Attribute;
+		EGameplayEffectAttributeCaptureSource Source;
+	};
+
+	static constexpr FCapturedAttribute CapturedAttributes[] =
+	{
+		{ EAuraAttribute::Armor, EGameplayEffectAttributeCaptureSource::Target },
+		{ EAuraAttribute::BlockChance, EGameplayEffectAttributeCaptureSource::Target },
+		{ EAuraAttribute::ArmorPenetration, EGameplayEffectAttributeCaptureSource::Source },
+		{ EAuraAttribute::CriticalHitChance, EGameplayEffectAttributeCaptureSource::Source },
+		{ EAuraAttribute::CriticalHitDamage, EGameplayEffectAttributeCaptureSource::Source },
+		{ EAuraAttribute::CriticalHitResistance, EGameplayEffectAttributeCaptureSource::Target },
+
+		{ EAuraAttribute::FireResistance, EGameplayEffectAttributeCaptureSource::Target },
+		{ EAuraAttribute::LightningResistance, EGameplayEffectAttributeCaptureSource::Target },
+		{ EAuraAttribute::ArcaneResistance, EGameplayEffectAttributeCaptureSource::Target },
+		{ EAuraAttribute::PhysicalResistance, EGameplayEffectAttributeCaptureSource::Target },
+	};
+
+	// Indexado por EAuraAttribute, solo los atributos de CapturedAttributes tienen definición válida.
+	FGameplayEffectAttributeCaptureDefinition CaptureDefs[static_cast<int32>(EAuraAttribute::Count)];
+
+	struct FDamageTypeResistance
+	{
+		EAuraGameplayTag DamageType;
+		EAuraAttribute Resistance;
+	};
+
+#define AURA_DAMAGE_TYPE_COUNT(DamageTypeMember, ResistanceMember) + 1
+	static constexpr int32 NumDamageTypes = 0 AURA_DAMAGE_TYPES(AURA_DAMAGE_TYPE_COUNT);
+#undef AURA_DAMAGE_TYPE_COUNT
+
+	// Mismo orden que FAuraGameplayTags::DamageTypesToResistances, resuelto una sola vez.
+	FDamageTypeResistance DamageTypes[NumDamageTypes];
+
 	AuraDamageStatics()
 	{
-		// Captura el atributo "Armor" de la clase UAuraAttributeSet para usarlo en cálculos de efectos.
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, Armor, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, BlockChance, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, ArmorPenetration, Source, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, CriticalHitChance, Source, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, CriticalHitDamage, Source, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, CriticalHitResistance, Target, false);
-
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, FireResistance, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, LightningResistance, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, ArcaneResistance, Target, false);
-		DEFINE_ATTRIBUTE_CAPTUREDEF(UAuraAttributeSet, PhysicalResistance, Target, false);
-
-		const FAuraGameplayTags& Tags = FAuraGameplayTags::Get();
-		TagsToCaptureDefs.Add(Tags.Attribute_Secondary_Armor, ArmorDef);
-		TagsToCaptureDefs.Add(Tags.Attribute_Secondary_BlockChance, BlockChanceDef);
-		TagsToCaptureDefs.Add(Tags.Attribute_Secondary_ArmorPenetration, ArmorPenetrationDef);
-		TagsToCaptureDefs.Add(Tags.Attribute_Secondary_CriticalHitChance, CriticalHitChanceDef);
-		TagsToCaptureDefs.Add(Tags.Attribute_Secondary_CriticalHitDamage, CriticalHitDamageDef);
-		TagsToCaptureDefs.Add(Tags.Attribute_Secondary_CriticalHitResistance, CriticalHitResistanceDef);
-
-		TagsToCaptureDefs.Add(Tags.Attribute_Resistance_Fire, FireResistanceDef);
-		TagsToCaptureDefs.Add(Tags.Attribute_Resistance_Lightning, LightningResistanceDef);
-		TagsToCaptureDefs.Add(Tags.Attribute_Resistance_Arcane, ArcaneResistanceDef);
-		TagsToCaptureDefs.Add(Tags.Attribute_Resistance_Physical, PhysicalResistanceDef);
-		
+		for (const FCapturedAttribute& Captured : CapturedAttributes)
+		{
+			const FAuraAttributeDescriptor& Descriptor = UAuraAttributeSet::GetAttributeDescriptor(Captured.Attribute);
+			CaptureDefs[static_cast<int32>(Captured.Attribute)] = FGameplayEffectAttributeCaptureDefinition(Descriptor.Attribute, Captured.Source, false);
+		}
+
+		// Matched by tag member, this runs from the CDO before the native tags have values.
+		int32 DamageTypeIndex = 0;
+#define AURA_DAMAGE_TYPE_RESOLVE(DamageTypeMember, ResistanceMember) \
+		DamageTypes[DamageTypeIndex++] = { EAuraGameplayTag::DamageTypeMember, FindCapturedAttribute(&FAuraGameplayTags::ResistanceMember) };
+		AURA_DAMAGE_TYPES(AURA_DAMAGE_TYPE_RESOLVE)
+#undef AURA_DAMAGE_TYPE_RESOLVE
+	}
+
+	static EAuraAttribute FindCapturedAttribute(FGameplayTag FAuraGameplayTags::* TagMember)
+	{
+		for (const FCapturedAttribute& Captured : CapturedAttributes)
+		{
+			if (UAuraAttributeSet::GetAttributeDescriptor(Captured.Attribute).TagMember == TagMember)
+			{
+				return Captured.Attribute;
+			}
+		}
+		checkf(false, TEXT("Resistance of a damage type is not captured by ExecCalc_Damage"));
+		return EAuraAttribute::None;
+	}
+
+	const FGameplayEffectAttributeCaptureDefinition& CaptureDef(EAuraAttribute Attribute) const
+	{
+		return CaptureDefs[static_cast<int32>(Attribute)];
 	}
 };
 
@@ -62,24 +103,110 @@ static const AuraDamageStatics& DamageStatics()
 	return DStatics;
 }
 
+/** One pass over the SetByCaller magnitudes of the spec: damage per type, in DamageTypes order. */
+static void GetDamageMagnitudes(const FGameplayEffectSpec& Spec, float (&OutDamageTypeValues)[AuraDamageStatics::NumDamageTypes])
+{
+	const FAuraGameplayTags& GameplayTags = FAuraGameplayTags::Get();
+	const AuraDamageStatics& Statics = DamageStatics();
+
+	for (float& DamageTypeValue : OutDamageTypeValues)
+	{
+		DamageTypeValue = 0.f;
+	}
+
+	for (const TPair<FGameplayTag, float>& SetByCaller : Spec.SetByCallerTagMagnitudes)
+	{
+		for (int32 DamageType = 0; DamageType < AuraDamageStatics::NumDamageTypes; ++DamageType)
+		{
+			if (SetByCaller.Key == GameplayTags.GetTag(Statics.DamageTypes[DamageType].DamageType))
+			{
+				OutDamageTypeValues[DamageType] = SetByCaller.Value;
+				break;
+			}
+		}
+	}
+}
+
+static uint32 HashEvaluationTags(const FAggregatorEvaluateParameters& EvaluationParameters)
+{
+	uint32 Hash = 0;
+	if (EvaluationParameters.SourceTags)
+	{
+		for (const FGameplayTag& Tag : *EvaluationParameters.SourceTags)
+		{
+			Hash = HashCombineFast(Hash, GetTypeHash(Tag));
+		}
+	}
+	Hash = HashCombineFast(Hash, MAX_uint32);
+	if (EvaluationParameters.TargetTags)
+	{
+		for (const FGameplayTag& Tag : *EvaluationParameters.TargetTags)
+		{
+			Hash = HashCombineFast(Hash, GetTypeHash(Tag));
+		}
+	}
+	return Hash;
+}
+
+// Calculation modifiers of the effect are applied on top of the captured aggregator, those evaluations can't be shared.
+static bool HasCalculationModifiers(const FGameplayEffectSpec& Spec)
+{
+	for (const FGameplayEffectExecutionDefinition& Execution : Spec.Def->Executions)
+	{
+		if (Execution.CalculationModifiers.Num() > 0) return true;
+	}
+	return false;
+}
+
+/** Captured attribute of the target, taken from the target's attribute snapshot when SnapshotASC is set. */
+static float CalculateTargetAttribute(const FGameplayEffectCustomExecutionParameters& ExecutionParams, const FAggregatorEvaluateParameters& EvaluationParameters,
+	UAuraAbilitySystemComponent* SnapshotASC, uint32 TagsHash, EAuraAttribute Attribute)
+{
+	float Value = 0.f;
+	if (SnapshotASC && SnapshotASC->FindAttributeSnapshot(Attribute, TagsHash, EvaluationParameters.SourceTags, EvaluationParameters.TargetTags, Value)) return Value;
+
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().CaptureDef(Attribute), EvaluationParameters, Value);
+	if (SnapshotASC)
+	{
+		SnapshotASC->StoreAttributeSnapshot(Attribute, TagsHash, EvaluationParameters.SourceTags, EvaluationParameters.TargetTags, Value);
+	}
+	return Value;
+}
+
+/** Periods elapsed since the periodic Spec started on TargetASC, from replicated server times. 0 for instant effects. */
+static int32 GetPeriodIndex(const UAbilitySystemComponent* TargetASC, const FGameplayEffectSpec& Spec)
+{
+	const float Period = Spec.GetPeriod();
+	if (Period <= 0.f || TargetASC == nullptr) return 0;
+
+	const UWorld* World = TargetASC->GetWorld();
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if (GameState == nullptr) return 0;
+
+	// Periodic executions run on the active effect's own spec
+	for (const FActiveGameplayEffect& ActiveEffect : &TargetASC->GetActiveGameplayEffects())
+	{
+		if (&ActiveEffect.Spec == &Spec)
+		{
+			return FMath::Max(FMath::RoundToInt((GameState->GetServerWorldTimeSeconds() - ActiveEffect.StartServerWorldTime) / Period), 0);
+		}
+	}
+	return 0;
+}
+
 UExecCalc_Damage::UExecCalc_Damage()
 {
-	RelevantAttributesToCapture.Add(DamageStatics().ArmorDef);
-	RelevantAttributesToCapture.Add(DamageStatics().BlockChanceDef);
-	RelevantAttributesToCapture.Add(DamageStatics().ArmorPenetrationDef);
-	RelevantAttributesToCapture.Add(DamageStatics().CriticalHitChanceDef);
-	RelevantAttributesToCapture.Add(DamageStatics().CriticalHitDamageDef);
-	RelevantAttributesToCapture.Add(DamageStatics().CriticalHitResistanceDef);
-
-	RelevantAttributesToCapture.Add(DamageStatics().FireResistanceDef);
-	RelevantAttributesToCapture.Add(DamageStatics().LightningResistanceDef);
-	RelevantAttributesToCapture.Add(DamageStatics().ArcaneResistanceDef);
-	RelevantAttributesToCapture.Add(DamageStatics().PhysicalResistanceDef);
+	for (const AuraDamageStatics::FCapturedAttribute& Captured : AuraDamageStatics::CapturedAttributes)
+	{
+		RelevantAttributesToCapture.Add(DamageStatics().CaptureDef(Captured.Attribute));
+	}
 }
 void UExecCalc_Damage::Execute_Implementation(
 	const FGameplayEffectCustomExecutionParameters& ExecutionParams,
 	FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_AuraDamageExecution);
+
 	// Obtener los componentes de Ability System del origen y el objetivo.
 	const UAbilitySystemComponent* SourceASC = ExecutionParams.GetSourceAbilitySystemComponent();
 	const UAbilitySystemComponent* TargetASC = ExecutionParams.GetTargetAbilitySystemComponent();
@@ -93,6 +220,9 @@ void UExecCalc_Damage::Execute_Implementation(
 	
 	// Especificación del efecto y tags de origen y objetivo.
 	const FGameplayEffectSpec& Spec = ExecutionParams.GetOwningSpec();
+
+	float DamageTypeValues[AuraDamageStatics::NumDamageTypes];
+	GetDamageMagnitudes(Spec, DamageTypeValues);
 	
 	const FGameplayTagContainer* SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
 	const FGameplayTagContainer* TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
@@ -101,114 +231,311 @@ void UExecCalc_Damage::Execute_Implementation(
 	FAggregatorEvaluateParameters EvaluationParameters;
 	EvaluationParameters.SourceTags = SourceTags;
 	EvaluationParameters.TargetTags = TargetTags;
+
+	// Muchos impactos contra el mismo objetivo en un frame evaluan sus agregadores una sola vez
+	UAuraAbilitySystemComponent* SnapshotASC = CVarAuraDamageTargetSnapshot.GetValueOnGameThread() && !HasCalculationModifiers(Spec) ? Cast<UAuraAbilitySystemComponent>(ExecutionParams.GetTargetAbilitySystemComponent()) : nullptr;
+	const uint32 TagsHash = SnapshotASC ? HashEvaluationTags(EvaluationParameters) : 0;
 	
+#if AURA_COMBAT_TRACE
+	FAuraCombatTraceRecord TraceRecord;
+#endif
+
 	float Damage = 0.f;
-	for (const TTuple<FGameplayTag, FGameplayTag>& Pair : FAuraGameplayTags::Get().DamageTypesToResistances)
-	{
-		const FGameplayTag DamageTypeTag = Pair.Key;
-		const FGameplayTag ResistanceTag = Pair.Value;
-		
-		checkf(AuraDamageStatics().TagsToCaptureDefs.Contains(ResistanceTag), TEXT("TagsToCaptureDefs doesn't contain tag: [%s] in ExecCalc_Damage"), *ResistanceTag.ToString());
-		const FGameplayEffectAttributeCaptureDefinition CaptureDef = AuraDamageStatics().TagsToCaptureDefs[ResistanceTag];
-		
-		float DamageTypeValue = Spec.GetSetByCallerMagnitude(Pair.Key);
-		
-		float Resistance = 0.f;
-		ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(CaptureDef, EvaluationParameters, Resistance);
-		Resistance = FMath::Clamp(Resistance, 0.f, 100.f);
-
-		DamageTypeValue *= (100.f - Resistance) / 100.f;
+	for (int32 DamageType = 0; DamageType < AuraDamageStatics::NumDamageTypes; ++DamageType)
+	{
+		// Sin SetByCaller para este tipo no hace falta evaluar su resistencia
+		if (DamageTypeValues[DamageType] == 0.f) continue;
+
+		const float Resistance = CalculateTargetAttribute(ExecutionParams, EvaluationParameters, SnapshotASC, TagsHash, DamageStatics().DamageTypes[DamageType].Resistance);
+
+		const float DamageTypeValue = AuraDamage::ApplyResistance(DamageTypeValues[DamageType], Resistance);
 		Damage += DamageTypeValue;
+
+#if AURA_COMBAT_TRACE
+		if (DamageType < FAuraCombatTraceRecord::MaxDamageTypes)
+		{
+			TraceRecord.DamageByType[DamageType] = DamageTypeValue;
+		}
+#endif
 	}
 
-	float TargetBlockChance = 0.f;
-	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().BlockChanceDef, EvaluationParameters, TargetBlockChance);
-	TargetBlockChance = FMath::Max<float>(TargetBlockChance, 0.f);
+	const float TargetBlockChance = FMath::Max<float>(CalculateTargetAttribute(ExecutionParams, EvaluationParameters, SnapshotASC, TagsHash, EAuraAttribute::BlockChance), 0.f);
 
-	float TargetArmor = 0.f;
-	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().ArmorDef, EvaluationParameters, TargetArmor);
-	TargetArmor = FMath::Max<float>(TargetArmor, 0.f);
+	const float TargetArmor = FMath::Max<float>(CalculateTargetAttribute(ExecutionParams, EvaluationParameters, SnapshotASC, TagsHash, EAuraAttribute::Armor), 0.f);
 
 	float SourceArmorPenetration = 0.f;
-	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().ArmorPenetrationDef, EvaluationParameters, SourceArmorPenetration);
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().CaptureDef(EAuraAttribute::ArmorPenetration), EvaluationParameters, SourceArmorPenetration);
 	SourceArmorPenetration = FMath::Max<float>(SourceArmorPenetration, 0.f);
 	
-	// Log inicial del daño base
-	UE_LOG(LogTemp, Log, TEXT("Daño inicial: %f"), Damage);
-	
-	// Normalizar BlockChance al rango [0, 1] y decidir si el ataque es bloqueado
-	const float NormalizedBlockChance = FMath::Clamp(TargetBlockChance / 100.f, 0.f, 1.f);
-	const bool bIsBlocked = FMath::FRand() < NormalizedBlockChance;
+	const float InitialDamage = Damage;
 	
 	FGameplayEffectContextHandle ContextHandle = Spec.GetContext();
+	const int32 TargetIndex = UAuraAbilitySystemLibrary::GetCombatTargetIndex(ContextHandle, TargetAvatar);
+	const int32 PeriodIndex = GetPeriodIndex(TargetASC, Spec);
+
+	// Decidir si el ataque es bloqueado
+	const bool bIsBlocked = AuraDamage::IsBlocked(TargetBlockChance, UAuraAbilitySystemLibrary::RollCombatRandom(ContextHandle, AuraDamage::GetRollIndex(TargetIndex, PeriodIndex, AuraDamage::BlockRollIndex)));
+	
 	//FGameplayEffectContext* EffectContext = ContextHandle.Get();
 	//FAuraGameplayEffectContext* AuraEffectContext = static_cast<FAuraGameplayEffectContext*>(EffectContext);
 
 	// Modificar el daño en caso de bloqueo
-	constexpr float BlockDamageReductionFactor = 0.5f; // Reducir al 50%
-	Damage = bIsBlocked ? Damage * BlockDamageReductionFactor : Damage;
+	Damage = bIsBlocked ? Damage * AuraDamage::BlockDamageReductionFactor : Damage;
 	UAuraAbilitySystemLibrary::SetIsBlockedHit(ContextHandle, bIsBlocked);
-
-	// Log de probabilidad de bloqueo y resultado
-	UE_LOG(LogTemp, Log, TEXT("Probabilidad de bloqueo (normalizada): %f, ¿Bloqueado?: %s"), 
-		NormalizedBlockChance, bIsBlocked ? TEXT("Sí") : TEXT("No"));
-
-	// Log de daño después de bloqueo
-	UE_LOG(LogTemp, Log, TEXT("Daño después de bloqueo: %f"), Damage);
 	
-	const UCharacterClassInfo* CharacterClassInfo = UAuraAbilitySystemLibrary::GetCharacterClassInfo(SourceAvatar);
+	const FAuraDamageCoefficients* DamageCoefficientsPtr = UAuraDamageCoefficientSubsystem::FindDamageCoefficients(SourceAvatar);
+	if (DamageCoefficientsPtr == nullptr)
+	{
+		UE_LOG(LogAuraCombat, Error, TEXT("ExecCalc_Damage: no character class info for %s, damage not applied"), *GetNameSafe(SourceAvatar));
+		return;
+	}
+	const FAuraDamageCoefficients& DamageCoefficients = *DamageCoefficientsPtr;
 	
-	const FRealCurve* ArmorPenetrationCurve = CharacterClassInfo->DamageCalculationCoefficients->FindCurve(FName("ArmorPenetration"), FString());
-	const float ArmorPenetrationCoefficient = ArmorPenetrationCurve->Eval(SourceCombatInterface->GetPlayerLevel());
+	const float ArmorPenetrationCoefficient = DamageCoefficients.GetArmorPenetration(SourceCombatInterface->GetPlayerLevel());
 	
-	//ArmorPenetration ignores a percentage of the targets armor.
-	const float EffectiveArmor = TargetArmor * (100 - SourceArmorPenetration * ArmorPenetrationCoefficient) / 100.f;
+	const float EffectiveArmor = AuraDamage::GetEffectiveArmor(TargetArmor, SourceArmorPenetration, ArmorPenetrationCoefficient);
 
-	const FRealCurve* ArmorCoefficient = CharacterClassInfo->DamageCalculationCoefficients->FindCurve(FName("EffectiveArmor"), FString());
-	const float EffectiveArmorCoefficient = ArmorCoefficient->Eval(TargetCombatInterface->GetPlayerLevel());
+	const float EffectiveArmorCoefficient = DamageCoefficients.GetEffectiveArmor(TargetCombatInterface->GetPlayerLevel());
 	
-	//Armor Ignores a percentage of incoming damage.
-	Damage*= (100 - EffectiveArmor * EffectiveArmorCoefficient) / 100.f;
+	Damage = AuraDamage::ApplyArmor(Damage, EffectiveArmor, EffectiveArmorCoefficient);
 	
 	float CriticalHitChance = 0.f;
-	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().CriticalHitChanceDef, EvaluationParameters, CriticalHitChance);
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().CaptureDef(EAuraAttribute::CriticalHitChance), EvaluationParameters, CriticalHitChance);
 	CriticalHitChance = FMath::Max<float>(CriticalHitChance, 0.f);
 
 	float CriticalHitDamage = 0.f;
-	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().CriticalHitDamageDef, EvaluationParameters, CriticalHitDamage);
+	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().CaptureDef(EAuraAttribute::CriticalHitDamage), EvaluationParameters, CriticalHitDamage);
 	CriticalHitDamage = FMath::Max<float>(CriticalHitDamage, 0.f);
 
-	float CriticalHitResistance = 0.f;
-	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().CriticalHitResistanceDef, EvaluationParameters, CriticalHitResistance);
-	CriticalHitResistance = FMath::Max<float>(CriticalHitResistance, 0.f);
+	const float CriticalHitResistance = FMath::Max<float>(CalculateTargetAttribute(ExecutionParams, EvaluationParameters, SnapshotASC, TagsHash, EAuraAttribute::CriticalHitResistance), 0.f);
 
-	const FRealCurve* CriticalHitResistanceCoefficient = CharacterClassInfo->DamageCalculationCoefficients->FindCurve(FName("CriticalHitResistance"), FString());
-	const float EffectiveCriticalHitResistanceCoefficient = CriticalHitResistanceCoefficient->Eval(TargetCombatInterface->GetPlayerLevel());
+	const float EffectiveCriticalHitResistanceCoefficient = DamageCoefficients.GetCriticalHitResistance(TargetCombatInterface->GetPlayerLevel());
 	
-
-	const float NormalizedCriticalHitChance = FMath::Clamp(CriticalHitChance / 100.f, 0.f, 1.f);
-	const float NormalizedCriticalHitResistance = FMath::Clamp(CriticalHitResistance / 100.f, 0.f, 1.f);
-	const bool bIsCritical = FMath::FRand() *  EffectiveCriticalHitResistanceCoefficient + NormalizedCriticalHitResistance < NormalizedCriticalHitChance;
-	constexpr  float CriticalHitDamageFactor = 2.f;
-	Damage = bIsCritical ? Damage * CriticalHitDamageFactor + CriticalHitDamage : Damage ;
+	const bool bIsCritical = AuraDamage::IsCritical(CriticalHitChance, CriticalHitResistance, EffectiveCriticalHitResistanceCoefficient, UAuraAbilitySystemLibrary::RollCombatRandom(ContextHandle, AuraDamage::GetRollIndex(TargetIndex, PeriodIndex, AuraDamage::CriticalRollIndex)));
+	Damage = bIsCritical ? Damage * AuraDamage::CriticalHitDamageFactor + CriticalHitDamage : Damage ;
 	UAuraAbilitySystemLibrary::SetIsCriticalHit(ContextHandle,bIsCritical);
 
-	
-	// Log de armadura y penetración
-	UE_LOG(LogTemp, Log, TEXT("Armadura efectiva: %f, Penetración de armadura: %f, Coeficiente: %f"), 
-		EffectiveArmor, SourceArmorPenetration, ArmorPenetrationCoefficient);
+	// Verbose queda filtrado en runtime antes de formatear y se elimina al compilar en Shipping
+	UE_LOG(LogAuraCombat, Verbose, TEXT("Daño inicial: %f, ¿Bloqueado?: %d, Armadura efectiva: %f, Penetración de armadura: %f, Coeficiente: %f, ¿Crítico?: %d, Daño final: %f"),
+		InitialDamage, bIsBlocked, EffectiveArmor, SourceArmorPenetration, ArmorPenetrationCoefficient, bIsCritical, Damage);
 
-	// Log de daño tras mitigación de armadura
-	UE_LOG(LogTemp, Log, TEXT("Daño después de mitigación por armadura: %f"), Damage);
-
-	// Log de probabilidad crítica y resultado
-	UE_LOG(LogTemp, Log, TEXT("Probabilidad crítica (normalizada): %f, Resistencia crítica (normalizada): %f, ¿Crítico?: %s"), 
-		NormalizedCriticalHitChance, NormalizedCriticalHitResistance, bIsCritical ? TEXT("Sí") : TEXT("No"));
-
-	// Log de daño final
-	UE_LOG(LogTemp, Log, TEXT("Daño final: %f"), Damage);
+#if AURA_COMBAT_TRACE
+	if (FAuraCombatTrace::IsEnabled())
+	{
+		TraceRecord.FrameNumber = GFrameCounter;
+		TraceRecord.Source = SourceAvatar;
+		TraceRecord.Target = TargetAvatar;
+		TraceRecord.FinalDamage = Damage;
+		TraceRecord.bIsBlockedHit = bIsBlocked;
+		TraceRecord.bIsCriticalHit = bIsCritical;
+		FAuraCombatTrace::Record(TraceRecord);
+	}
+#endif
 	
 	// Crear y añadir el modificador evaluado al output
 	const FGameplayModifierEvaluatedData EvaluatedData(UAuraAttributeSet::GetIncomingDamageAttribute(), EGameplayModOp::Additive, Damage);
 	OutExecutionOutput.AddOutputModifier(EvaluatedData); 
 }
+
+void FAuraDamageBatch::SetNum(int32 NumTargets, int32 NumDamageTypes)
+{
+	Armor.SetNumZeroed(NumTargets);
+	BlockChance.SetNumZeroed(NumTargets);
+	CriticalHitResistance.SetNumZeroed(NumTargets);
+	EffectiveArmorCoefficient.SetNumZeroed(NumTargets);
+	CriticalHitResistanceCoefficient.SetNumZeroed(NumTargets);
+	Resistances.SetNum(NumDamageTypes);
+	for (TArray<float>& DamageTypeResistances : Resistances)
+	{
+		DamageTypeResistances.SetNumZeroed(NumTargets);
+	}
+	ArmorPenetration.SetNumZeroed(NumTargets);
+	CriticalHitChance.SetNumZeroed(NumTargets);
+	CriticalHitDamage.SetNumZeroed(NumTargets);
+	BlockRoll.SetNumZeroed(NumTargets);
+	CriticalRoll.SetNumZeroed(NumTargets);
+	Damage.SetNumZeroed(NumTargets);
+	bIsBlockedHit.SetNumZeroed(NumTargets);
+	bIsCriticalHit.SetNumZeroed(NumTargets);
+}
+
+bool UExecCalc_Damage::SupportsDamageBatch(const FGameplayEffectSpec& Spec)
+{
+	// The batch only commits IncomingDamage, anything else the effect does needs a real application
+	const UGameplayEffect* Def = Spec.Def;
+	if (Def == nullptr || Def->DurationPolicy != EGameplayEffectDurationType::Instant) return false;
+	if (Def->Modifiers.Num() > 0 || Def->GameplayCues.Num() > 0 || Def->Executions.Num() != 1) return false;
+
+	const FGameplayEffectExecutionDefinition& Execution = Def->Executions[0];
+	return Execution.CalculationClass == UExecCalc_Damage::StaticClass()
+		&& Execution.CalculationModifiers.Num() == 0
+		&& Execution.ConditionalGameplayEffects.Num() == 0;
+}
+
+/** Same evaluation as AttemptCalculateCapturedAttributeMagnitude on a spec captured from CaptureASC. */
+static float CalculateCapturedAttribute(const FGameplayEffectAttributeCaptureSpec* CaptureSpec, const FAggregatorEvaluateParameters& EvaluationParameters)
+{
+	float Value = 0.f;
+	if (CaptureSpec)
+	{
+		CaptureSpec->AttemptCalculateAttributeMagnitude(EvaluationParameters, Value);
+	}
+	return Value;
+}
+
+bool UExecCalc_Damage::CalculateDamageBatch(const FGameplayEffectSpec& Spec, const TArray<UAbilitySystemComponent*>& TargetASCs, FAuraDamageBatch& OutBatch)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraDamageBatch);
+
+	const AuraDamageStatics& Statics = DamageStatics();
+
+	OutBatch.TargetASCs.Reset(TargetASCs.Num());
+	OutBatch.TargetIndex.Reset(TargetASCs.Num());
+	for (int32 TargetIndex = 0; TargetIndex < TargetASCs.Num(); ++TargetIndex)
+	{
+		UAbilitySystemComponent* TargetASC = TargetASCs[TargetIndex];
+		if (IsValid(TargetASC) && Cast<ICombatInterface>(TargetASC->GetAvatarActor()))
+		{
+			OutBatch.TargetASCs.Add(TargetASC);
+			OutBatch.TargetIndex.Add(TargetIndex);
+		}
+	}
+	const int32 NumTargets = OutBatch.Num();
+	OutBatch.SetNum(NumTargets, AuraDamageStatics::NumDamageTypes);
+	if (NumTargets == 0) return true;
+
+	const UAbilitySystemComponent* SourceASC = Spec.GetContext().GetOriginalInstigatorAbilitySystemComponent();
+	AActor* SourceAvatar = SourceASC ? SourceASC->GetAvatarActor() : nullptr;
+	ICombatInterface* SourceCombatInterface = Cast<ICombatInterface>(SourceAvatar);
+	const FAuraDamageCoefficients* DamageCoefficientsPtr = UAuraDamageCoefficientSubsystem::FindDamageCoefficients(SourceAvatar);
+	if (SourceCombatInterface == nullptr || DamageCoefficientsPtr == nullptr)
+	{
+		UE_LOG(LogAuraCombat, Error, TEXT("CalculateDamageBatch: %s has no combat interface or character class info, damage not applied"), *GetNameSafe(SourceAvatar));
+		OutBatch.TargetASCs.Reset();
+		OutBatch.TargetIndex.Reset();
+		OutBatch.SetNum(0, AuraDamageStatics::NumDamageTypes);
+		return false;
+	}
+
+	const FAuraDamageCoefficients& DamageCoefficients = *DamageCoefficientsPtr;
+	const float ArmorPenetrationCoefficient = DamageCoefficients.GetArmorPenetration(SourceCombatInterface->GetPlayerLevel());
+
+	float DamageTypeValues[AuraDamageStatics::NumDamageTypes];
+	GetDamageMagnitudes(Spec, DamageTypeValues);
+
+	// Source attributes were captured when the spec was made, like for the single target execution
+	const FGameplayEffectAttributeCaptureSpec* ArmorPenetrationCapture = Spec.CapturedRelevantAttributes.FindCaptureSpecByDefinition(Statics.CaptureDef(EAuraAttribute::ArmorPenetration), true);
+	const FGameplayEffectAttributeCaptureSpec* CriticalHitChanceCapture = Spec.CapturedRelevantAttributes.FindCaptureSpecByDefinition(Statics.CaptureDef(EAuraAttribute::CriticalHitChance), true);
+	const FGameplayEffectAttributeCaptureSpec* CriticalHitDamageCapture = Spec.CapturedRelevantAttributes.FindCaptureSpecByDefinition(Statics.CaptureDef(EAuraAttribute::CriticalHitDamage), true);
+
+	// Batched specs are instant, every target rolls in period 0
+	const FGameplayEffectContextHandle ContextHandle = Spec.GetContext();
+
+	// Target tags as ApplyGameplayEffectSpecToSelf captures them: owned tags plus the spec's target spec tags.
+	FGameplayTagContainer TargetTags;
+	FAggregatorEvaluateParameters EvaluationParameters;
+	EvaluationParameters.SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+	EvaluationParameters.TargetTags = &TargetTags;
+
+	FGameplayEffectAttributeCaptureSpec TargetCaptures[static_cast<int32>(EAuraAttribute::Count)] = {};
+
+	// Gather, through the aggregators with the same tags as the single target execution.
+	for (int32 Index = 0; Index < NumTargets; ++Index)
+	{
+		UAbilitySystemComponent* TargetASC = OutBatch.TargetASCs[Index];
+		const int32 TargetLevel = Cast<ICombatInterface>(TargetASC->GetAvatarActor())->GetPlayerLevel();
+
+		TargetASC->GetOwnedGameplayTags(TargetTags);
+		TargetTags.AppendTags(Spec.CapturedTargetTags.GetSpecTags());
+
+		for (const AuraDamageStatics::FCapturedAttribute& Captured : AuraDamageStatics::CapturedAttributes)
+		{
+			if (Captured.Source != EGameplayEffectAttributeCaptureSource::Target) continue;
+
+			FGameplayEffectAttributeCaptureSpec& TargetCapture = TargetCaptures[static_cast<int32>(Captured.Attribute)];
+			TargetCapture = FGameplayEffectAttributeCaptureSpec(Statics.CaptureDef(Captured.Attribute));
+			TargetASC->CaptureAttributeForGameplayEffect(TargetCapture);
+		}
+		auto TargetAttribute = [&TargetCaptures, &EvaluationParameters](EAuraAttribute Attribute)
+		{
+			return CalculateCapturedAttribute(&TargetCaptures[static_cast<int32>(Attribute)], EvaluationParameters);
+		};
+
+		OutBatch.Armor[Index] = FMath::Max<float>(TargetAttribute(EAuraAttribute::Armor), 0.f);
+		OutBatch.BlockChance[Index] = FMath::Max<float>(TargetAttribute(EAuraAttribute::BlockChance), 0.f);
+		OutBatch.CriticalHitResistance[Index] = FMath::Max<float>(TargetAttribute(EAuraAttribute::CriticalHitResistance), 0.f);
+		for (int32 DamageType = 0; DamageType < AuraDamageStatics::NumDamageTypes; ++DamageType)
+		{
+			// Sin SetByCaller para este tipo no hace falta evaluar su resistencia
+			if (DamageTypeValues[DamageType] == 0.f) continue;
+			OutBatch.Resistances[DamageType][Index] = TargetAttribute(Statics.DamageTypes[DamageType].Resistance);
+		}
+
+		// Source modifiers may require target tags, so they are evaluated per target too.
+		OutBatch.ArmorPenetration[Index] = FMath::Max<float>(CalculateCapturedAttribute(ArmorPenetrationCapture, EvaluationParameters), 0.f);
+		OutBatch.CriticalHitChance[Index] = FMath::Max<float>(CalculateCapturedAttribute(CriticalHitChanceCapture, EvaluationParameters), 0.f);
+		OutBatch.CriticalHitDamage[Index] = FMath::Max<float>(CalculateCapturedAttribute(CriticalHitDamageCapture, EvaluationParameters), 0.f);
+
+		OutBatch.EffectiveArmorCoefficient[Index] = DamageCoefficients.GetEffectiveArmor(TargetLevel);
+		OutBatch.CriticalHitResistanceCoefficient[Index] = DamageCoefficients.GetCriticalHitResistance(TargetLevel);
+
+		OutBatch.BlockRoll[Index] = UAuraAbilitySystemLibrary::RollCombatRandom(ContextHandle, AuraDamage::GetRollIndex(OutBatch.TargetIndex[Index], 0, AuraDamage::BlockRollIndex));
+		OutBatch.CriticalRoll[Index] = UAuraAbilitySystemLibrary::RollCombatRandom(ContextHandle, AuraDamage::GetRollIndex(OutBatch.TargetIndex[Index], 0, AuraDamage::CriticalRollIndex));
+	}
+
+	// Mitigate every target with straight loops over the gathered arrays.
+	float* RESTRICT Damage = OutBatch.Damage.GetData();
+	for (int32 DamageType = 0; DamageType < AuraDamageStatics::NumDamageTypes; ++DamageType)
+	{
+		const float DamageTypeValue = DamageTypeValues[DamageType];
+		if (DamageTypeValue == 0.f) continue;
+
+		const float* RESTRICT Resistance = OutBatch.Resistances[DamageType].GetData();
+		for (int32 Index = 0; Index < NumTargets; ++Index)
+		{
+			Damage[Index] += AuraDamage::ApplyResistance(DamageTypeValue, Resistance[Index]);
+		}
+	}
+
+	for (int32 Index = 0; Index < NumTargets; ++Index)
+	{
+		const bool bIsBlocked = AuraDamage::IsBlocked(OutBatch.BlockChance[Index], OutBatch.BlockRoll[Index]);
+		Damage[Index] *= bIsBlocked ? AuraDamage::BlockDamageReductionFactor : 1.f;
+		OutBatch.bIsBlockedHit[Index] = bIsBlocked;
+	}
+
+	for (int32 Index = 0; Index < NumTargets; ++Index)
+	{
+		const float EffectiveArmor = AuraDamage::GetEffectiveArmor(OutBatch.Armor[Index], OutBatch.ArmorPenetration[Index], ArmorPenetrationCoefficient);
+		Damage[Index] = AuraDamage::ApplyArmor(Damage[Index], EffectiveArmor, OutBatch.EffectiveArmorCoefficient[Index]);
+	}
+
+	for (int32 Index = 0; Index < NumTargets; ++Index)
+	{
+		const bool bIsCritical = AuraDamage::IsCritical(OutBatch.CriticalHitChance[Index], OutBatch.CriticalHitResistance[Index], OutBatch.CriticalHitResistanceCoefficient[Index], OutBatch.CriticalRoll[Index]);
+		Damage[Index] = bIsCritical ? Damage[Index] * AuraDamage::CriticalHitDamageFactor + OutBatch.CriticalHitDamage[Index] : Damage[Index];
+		OutBatch.bIsCriticalHit[Index] = bIsCritical;
+	}
+
+#if AURA_COMBAT_TRACE
+	if (FAuraCombatTrace::IsEnabled())
+	{
+		for (int32 Index = 0; Index < NumTargets; ++Index)
+		{
+			FAuraCombatTraceRecord TraceRecord;
+			TraceRecord.FrameNumber = GFrameCounter;
+			TraceRecord.Source = SourceAvatar;
+			TraceRecord.Target = OutBatch.TargetASCs[Index]->GetAvatarActor();
+			for (int32 DamageType = 0; DamageType < FMath::Min<int32>(AuraDamageStatics::NumDamageTypes, FAuraCombatTraceRecord::MaxDamageTypes); ++DamageType)
+			{
+				TraceRecord.DamageByType[DamageType] = AuraDamage::ApplyResistance(DamageTypeValues[DamageType], OutBatch.Resistances[DamageType][Index]);
+			}
+			TraceRecord.FinalDamage = Damage[Index];
+			TraceRecord.bIsBlockedHit = OutBatch.bIsBlockedHit[Index];
+			TraceRecord.bIsCriticalHit = OutBatch.bIsCriticalHit[Index];
+			FAuraCombatTrace::Record(TraceRecord);
+		}
+	}
+#endif
+	return true;
+}
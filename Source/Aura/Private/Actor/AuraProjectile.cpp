@@ -8,7 +8,9 @@
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Aura/Aura.h"
+#include "Actor/AuraProjectilePoolSubsystem.h"
 #include "Components/AudioComponent.h"
+#include "Net/UnrealNetwork.h"
 
 
 AAuraProjectile::AAuraProjectile()
@@ -31,25 +33,44 @@ AAuraProjectile::AAuraProjectile()
 	ProjectileMovement->ProjectileGravityScale = 0.f;
 }
 
+void AAuraProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(AAuraProjectile, Activation);
+}
+
+float AAuraProjectile::GetCollisionRadius() const
+{
+	return Sphere->GetScaledSphereRadius();
+}
 
 void AAuraProjectile::BeginPlay()
 {
 	Super::BeginPlay();
 	Sphere->OnComponentBeginOverlap.AddDynamic(this, &ThisClass::OnSphereOverlap);
 
-	AttachedHissSound= UGameplayStatics::SpawnSoundAttached(HissSound, GetRootComponent());
+	if (bPooled)
+	{
+		// Pooled projectiles outlive InitialLifeSpan, it is restarted on every activation instead.
+		PooledLifeSpan = InitialLifeSpan;
+		SetLifeSpan(0.f);
+	}
+
+	if (Activation.bActive)
+	{
+		StartHissSound();
+	}
+	else
+	{
+		ApplyActivation();
+	}
 }
 
 void AAuraProjectile::Destroyed()
 {
-	if (!bHit && !HasAuthority())
+	if (!bHit && !HasAuthority() && Activation.bActive)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation(), FRotator::ZeroRotator);
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, ImpactEffect, GetActorLocation());
-		if (AttachedHissSound)
-		{
-			AttachedHissSound->Stop();
-		}
+		PlayImpactEffects();
 	}
 	Super::Destroyed();
 }
@@ -57,6 +78,8 @@ void AAuraProjectile::Destroyed()
 void AAuraProjectile::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
                                       UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	if (!Activation.bActive) return;
+
 	if (DamageEffectSpecHandle.Data.IsValid() && DamageEffectSpecHandle.Data.Get()->GetContext().GetEffectCauser() == OtherActor)
 	{
 		return;
@@ -64,12 +87,7 @@ void AAuraProjectile::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent,
 
 	if (!bHit)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation(), FRotator::ZeroRotator);
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, ImpactEffect, GetActorLocation());
-		if (AttachedHissSound)
-		{
-			AttachedHissSound->Stop();
-		}
+		PlayImpactEffects();
 	}
 	
 	if (HasAuthority())
@@ -78,7 +96,7 @@ void AAuraProjectile::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent,
 		{
 			TargetASC->ApplyGameplayEffectSpecToSelf(*DamageEffectSpecHandle.Data.Get());
 		}
-		Destroy();
+		Finish();
 	}
 	else
 	{
@@ -86,4 +104,116 @@ void AAuraProjectile::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent,
 	}
 }
 
+void AAuraProjectile::ActivatePooled(const FTransform& Transform)
+{
+	// Pooled projectiles sleep between activations, wake the channel before changing replicated state
+	FlushNetDormancy();
+	SetNetDormancy(DORM_Awake);
+
+	Activation.bActive = true;
+	Activation.ActivationCount++;
+	Activation.Location = Transform.GetLocation();
+	Activation.Rotation = Transform.Rotator();
+	ApplyActivation();
+	StartHissSound();
+	ForceNetUpdate();
+
+	if (PooledLifeSpan > 0.f)
+	{
+		GetWorldTimerManager().SetTimer(PooledLifeSpanTimer, this, &AAuraProjectile::Finish, PooledLifeSpan);
+	}
+}
+
+void AAuraProjectile::DeactivatePooled()
+{
+	Activation.bActive = false;
+	ApplyActivation();
+	ForceNetUpdate();
 
+	// The deactivation goes out with the last update before the channel goes dormant
+	SetNetDormancy(DORM_DormantAll);
+
+	GetWorldTimerManager().ClearTimer(PooledLifeSpanTimer);
+	DamageEffectSpecHandle = FGameplayEffectSpecHandle();
+}
+
+void AAuraProjectile::OnRep_Activation(const FAuraProjectileActivation& OldActivation)
+{
+	// BeginPlay aplica el estado inicial
+	if (!HasActorBegunPlay()) return;
+
+	// Mismo comportamiento que Destroyed para proyectiles que no llegaron a impactar en el cliente
+	if (OldActivation.bActive && !bHit)
+	{
+		PlayImpactEffects();
+	}
+	ApplyActivation();
+	if (Activation.bActive)
+	{
+		StartHissSound();
+	}
+}
+
+void AAuraProjectile::ApplyActivation()
+{
+	bHit = false;
+	// Sin colision durante el teletransporte, si no el proyectil reciclado solapa lo ultimo que golpeo con el spec nuevo
+	Sphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetActorHiddenInGame(!Activation.bActive);
+
+	if (Activation.bActive)
+	{
+		SetActorLocationAndRotation(Activation.Location, Activation.Rotation, false, nullptr, ETeleportType::ResetPhysics);
+		Sphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		ProjectileMovement->SetUpdatedComponent(GetRootComponent());
+		ProjectileMovement->Velocity = GetActorForwardVector() * ProjectileMovement->InitialSpeed;
+		ProjectileMovement->UpdateComponentVelocity();
+		ProjectileMovement->SetComponentTickEnabled(true);
+	}
+	else
+	{
+		ProjectileMovement->StopMovementImmediately();
+		ProjectileMovement->SetComponentTickEnabled(false);
+		StopHissSound();
+	}
+}
+
+void AAuraProjectile::PlayImpactEffects()
+{
+	UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation(), FRotator::ZeroRotator);
+	UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, ImpactEffect, GetActorLocation());
+	StopHissSound();
+}
+
+void AAuraProjectile::StartHissSound()
+{
+	if (AttachedHissSound)
+	{
+		AttachedHissSound->Play();
+		return;
+	}
+	// Sin auto destroy para poder reutilizar el componente entre activaciones
+	AttachedHissSound = UGameplayStatics::SpawnSoundAttached(HissSound, GetRootComponent(), NAME_None, FVector(ForceInit),
+		EAttachLocation::KeepRelativeOffset, false, 1.f, 1.f, 0.f, nullptr, nullptr, false);
+}
+
+void AAuraProjectile::StopHissSound()
+{
+	if (AttachedHissSound)
+	{
+		AttachedHissSound->Stop();
+	}
+}
+
+void AAuraProjectile::Finish()
+{
+	if (!bPooled)
+	{
+		Destroy();
+		return;
+	}
+	if (UAuraProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UAuraProjectilePoolSubsystem>())
+	{
+		Pool->ReleaseProjectile(this);
+	}
+}
@@ -0,0 +1,399 @@
+
+#include "Actor/AuraProjectileManager.h"
+
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystem/Abilities/AuraDamageGameplayAbility.h"
+#include "Actor/AuraProjectile.h"
+#include "Actor/AuraProjectileManagerSubsystem.h"
+#include "Aura/Aura.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "NiagaraComponent.h"
+#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "NiagaraFunctionLibrary.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Batched Projectiles Step"), STAT_AuraBatchedProjectilesStep, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Projectiles"), STAT_AuraBatchedProjectiles, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Projectile Pawn Sweeps"), STAT_AuraBatchedProjectilePawnSweeps, STATGROUP_Aura);
+
+static TAutoConsoleVariable<bool> CVarAuraProjectileBroadphase(
+	TEXT("Aura.Projectiles.Broadphase"),
+	true,
+	TEXT("Only sweeps batched projectiles against pawns when their step overlaps a pawn in the grid. Disable to sweep every projectile every tick, see Aura.Projectiles.LoadTest."));
+
+namespace AuraBatchedProjectiles
+{
+	// Used when the projectile class has no InitialLifeSpan, so missed shots don't live forever.
+	constexpr float DefaultLifeSpan = 10.f;
+
+	// Roughly a character capsule, most projectile steps touch one or two cells.
+	constexpr float PawnGridCellSize = 256.f;
+
+	// Keeps each multicast well under the bunch size limit.
+	constexpr int32 MaxSpawnsPerMulticast = 64;
+
+	static FIntVector GetPawnGridCell(const FVector& Location)
+	{
+		return FIntVector(
+			FMath::FloorToInt(Location.X / PawnGridCellSize),
+			FMath::FloorToInt(Location.Y / PawnGridCellSize),
+			FMath::FloorToInt(Location.Z / PawnGridCellSize));
+	}
+
+	static const FName PositionsParameterName("Positions");
+
+	// Round trips Origin and Direction through their NetSerialize so the server steps the values clients receive.
+	static void QuantizeSpawn(FAuraBatchedProjectileSpawn& Spawn)
+	{
+		bool bSuccess = true;
+		FBitWriter Writer(256, true);
+		Spawn.Origin.NetSerialize(Writer, nullptr, bSuccess);
+		Spawn.Direction.NetSerialize(Writer, nullptr, bSuccess);
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		Spawn.Origin.NetSerialize(Reader, nullptr, bSuccess);
+		Spawn.Direction.NetSerialize(Reader, nullptr, bSuccess);
+	}
+}
+
+AAuraProjectileManager::AAuraProjectileManager()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	SetReplicatingMovement(false);
+}
+
+void AAuraProjectileManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AAuraProjectileManager, RegisteredClasses, Params);
+}
+
+void AAuraProjectileManager::BeginPlay()
+{
+	Super::BeginPlay();
+	if (UAuraProjectileManagerSubsystem* Subsystem = GetWorld()->GetSubsystem<UAuraProjectileManagerSubsystem>())
+	{
+		Subsystem->RegisterProjectileManager(this);
+	}
+}
+
+void AAuraProjectileManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAuraProjectileManagerSubsystem* Subsystem = GetWorld()->GetSubsystem<UAuraProjectileManagerSubsystem>())
+	{
+		Subsystem->UnregisterProjectileManager(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void AAuraProjectileManager::SpawnProjectile(TSubclassOf<AAuraProjectile> ProjectileClass, const FVector& Origin, const FVector& Direction, float SpreadDegrees, AActor* Causer, const FGameplayEffectSpecHandle& DamageEffectSpecHandle)
+{
+	if (!HasAuthority() || ProjectileClass == nullptr) return;
+
+	const int32 ClassIndex = RegisterProjectileClass(ProjectileClass);
+	if (ClassIndex == INDEX_NONE) return;
+
+	FAuraBatchedProjectileSpawn Spawn;
+	Spawn.ClassIndex = static_cast<uint8>(ClassIndex);
+	Spawn.Origin = Origin;
+	Spawn.Direction = Direction.GetSafeNormal();
+	Spawn.Seed = UAuraDamageGameplayAbility::MakeCombatSeed();
+	Spawn.SpreadDegrees = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(SpreadDegrees), 0, 180));
+	AuraBatchedProjectiles::QuantizeSpawn(Spawn);
+
+	AddProjectile(ProjectileClass, Spawn, Causer, DamageEffectSpecHandle);
+	PendingSpawns.FindOrAdd(Causer).Add(Spawn);
+}
+
+int32 AAuraProjectileManager::RegisterProjectileClass(TSubclassOf<AAuraProjectile> ProjectileClass)
+{
+	int32 ClassIndex = RegisteredClasses.Find(ProjectileClass);
+	if (ClassIndex != INDEX_NONE) return ClassIndex;
+
+	if (RegisteredClasses.Num() > MAX_uint8)
+	{
+		UE_LOG(LogAuraCombat, Warning, TEXT("AAuraProjectileManager: more than %d batched projectile classes, %s is not spawned"), MAX_uint8 + 1, *GetNameSafe(ProjectileClass));
+		return INDEX_NONE;
+	}
+
+	ClassIndex = RegisteredClasses.Add(ProjectileClass);
+	MARK_PROPERTY_DIRTY_FROM_NAME(AAuraProjectileManager, RegisteredClasses, this);
+	return ClassIndex;
+}
+
+void AAuraProjectileManager::MulticastSpawnProjectiles_Implementation(AActor* Causer, const TArray<FAuraBatchedProjectileSpawn>& Spawns)
+{
+	// El servidor ya los agregó en SpawnProjectile
+	if (HasAuthority()) return;
+
+	for (const FAuraBatchedProjectileSpawn& Spawn : Spawns)
+	{
+		// The class may still be on its way, the spawn is dropped like a lost multicast
+		if (RegisteredClasses.IsValidIndex(Spawn.ClassIndex))
+		{
+			AddProjectile(RegisteredClasses[Spawn.ClassIndex], Spawn, Causer, FGameplayEffectSpecHandle());
+		}
+	}
+}
+
+void AAuraProjectileManager::SendPendingSpawns()
+{
+	for (TTuple<TWeakObjectPtr<AActor>, TArray<FAuraBatchedProjectileSpawn>>& Pair : PendingSpawns)
+	{
+		const TArray<FAuraBatchedProjectileSpawn>& Spawns = Pair.Value;
+		for (int32 First = 0; First < Spawns.Num(); First += AuraBatchedProjectiles::MaxSpawnsPerMulticast)
+		{
+			const int32 Count = FMath::Min(AuraBatchedProjectiles::MaxSpawnsPerMulticast, Spawns.Num() - First);
+			MulticastSpawnProjectiles(Pair.Key.Get(), TArray<FAuraBatchedProjectileSpawn>(Spawns.GetData() + First, Count));
+		}
+	}
+	PendingSpawns.Reset();
+}
+
+void AAuraProjectileManager::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (PendingSpawns.Num() > 0)
+	{
+		SendPendingSpawns();
+	}
+
+	StepProjectiles(DeltaSeconds);
+
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		UpdateVisuals();
+	}
+}
+
+void AAuraProjectileManager::AddProjectile(TSubclassOf<AAuraProjectile> ProjectileClass, const FAuraBatchedProjectileSpawn& Spawn, AActor* Causer, const FGameplayEffectSpecHandle& DamageEffectSpecHandle)
+{
+	if (ProjectileClass == nullptr) return;
+
+	const AAuraProjectile* ProjectileCDO = ProjectileClass->GetDefaultObject<AAuraProjectile>();
+
+	FVector Direction = Spawn.Direction;
+	if (Spawn.SpreadDegrees > 0)
+	{
+		const FRandomStream RandomStream(Spawn.Seed);
+		Direction = RandomStream.VRandCone(Direction, FMath::DegreesToRadians(static_cast<float>(Spawn.SpreadDegrees)));
+	}
+
+	const FVector Velocity = Direction * ProjectileCDO->ProjectileMovement->InitialSpeed;
+	const float Radius = ProjectileCDO->GetCollisionRadius();
+	const float LifeSpan = ProjectileCDO->InitialLifeSpan > 0.f ? ProjectileCDO->InitialLifeSpan : AuraBatchedProjectiles::DefaultLifeSpan;
+
+	// Mismos tipos de objeto contra los que solapa la esfera de AAuraProjectile, sin pawns: esos van por el grid.
+	// Flight is a straight line, so world geometry is swept once for the whole lifespan.
+	FCollisionObjectQueryParams WallQueryParams;
+	WallQueryParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	WallQueryParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AuraBatchedProjectileWall), false, Causer);
+
+	FHitResult WallHit;
+	float WallTime = FLT_MAX;
+	if (GetWorld()->SweepSingleByObjectType(WallHit, Spawn.Origin, Spawn.Origin + Velocity * LifeSpan, FQuat::Identity, WallQueryParams, FCollisionShape::MakeSphere(Radius), QueryParams))
+	{
+		WallTime = WallHit.Time * LifeSpan;
+	}
+
+	Positions.Add(Spawn.Origin);
+	Velocities.Add(Velocity);
+	Radii.Add(Radius);
+	RemainingLifeSpans.Add(LifeSpan);
+	RemainingWallTimes.Add(WallTime);
+	WallHits.Add(WallHit);
+	Causers.Add(Causer);
+	DamageEffectSpecHandles.Add(DamageEffectSpecHandle);
+	ProjectileClasses.Add(ProjectileClass);
+}
+
+void AAuraProjectileManager::RemoveProjectile(int32 Index)
+{
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Radii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingLifeSpans.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingWallTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	WallHits.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Causers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	DamageEffectSpecHandles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ProjectileClasses.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void AAuraProjectileManager::BuildPawnGrid()
+{
+	PawnGridCells.Reset();
+	PawnBounds.Reset();
+	PawnActors.Reset();
+
+	for (TActorIterator<APawn> PawnIt(GetWorld()); PawnIt; ++PawnIt)
+	{
+		const UPrimitiveComponent* Root = Cast<UPrimitiveComponent>(PawnIt->GetRootComponent());
+		if (Root == nullptr || !Root->IsCollisionEnabled()) continue;
+
+		const FBox Bounds = Root->Bounds.GetBox();
+		const int32 PawnIndex = PawnBounds.Add(Bounds);
+		PawnActors.Add(*PawnIt);
+
+		const FIntVector MinCell = AuraBatchedProjectiles::GetPawnGridCell(Bounds.Min);
+		const FIntVector MaxCell = AuraBatchedProjectiles::GetPawnGridCell(Bounds.Max);
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+				{
+					PawnGridCells.FindOrAdd(FIntVector(X, Y, Z)).Add(PawnIndex);
+				}
+			}
+		}
+	}
+}
+
+bool AAuraProjectileManager::HasPawnCandidate(const FBox& SweepBounds, const AActor* Causer) const
+{
+	const FIntVector MinCell = AuraBatchedProjectiles::GetPawnGridCell(SweepBounds.Min);
+	const FIntVector MaxCell = AuraBatchedProjectiles::GetPawnGridCell(SweepBounds.Max);
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<int32>* Cell = PawnGridCells.Find(FIntVector(X, Y, Z));
+				if (Cell == nullptr) continue;
+
+				for (const int32 PawnIndex : *Cell)
+				{
+					if (PawnActors[PawnIndex] != Causer && PawnBounds[PawnIndex].Intersect(SweepBounds))
+					{
+						return true;
+					}
+				}
+			}
+		}
+	}
+	return false;
+}
+
+void AAuraProjectileManager::StepProjectiles(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraBatchedProjectilesStep);
+	SET_DWORD_STAT(STAT_AuraBatchedProjectiles, Positions.Num());
+
+	if (Positions.Num() == 0) return;
+
+	UWorld* World = GetWorld();
+	const bool bUseBroadphase = CVarAuraProjectileBroadphase.GetValueOnGameThread();
+	if (bUseBroadphase)
+	{
+		BuildPawnGrid();
+	}
+
+	FCollisionObjectQueryParams PawnQueryParams;
+	PawnQueryParams.AddObjectTypesToQuery(ECC_Pawn);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AuraBatchedProjectile), false);
+
+	// Iterate backwards so RemoveAtSwap only moves already stepped projectiles.
+	for (int32 Index = Positions.Num() - 1; Index >= 0; --Index)
+	{
+		RemainingLifeSpans[Index] -= DeltaSeconds;
+		if (RemainingLifeSpans[Index] <= 0.f)
+		{
+			RemoveProjectile(Index);
+			continue;
+		}
+
+		// The step ends at the wall when it gets there this tick
+		const bool bReachesWall = RemainingWallTimes[Index] <= DeltaSeconds;
+		const FVector Start = Positions[Index];
+		const FVector End = Start + Velocities[Index] * (bReachesWall ? RemainingWallTimes[Index] : DeltaSeconds);
+		RemainingWallTimes[Index] -= DeltaSeconds;
+
+		const AActor* Causer = Causers[Index].Get();
+		const FBox SweepBounds = FBox(Start.ComponentMin(End), Start.ComponentMax(End)).ExpandBy(Radii[Index]);
+		if (!bUseBroadphase || HasPawnCandidate(SweepBounds, Causer))
+		{
+			INC_DWORD_STAT(STAT_AuraBatchedProjectilePawnSweeps);
+
+			QueryParams.ClearIgnoredActors();
+			QueryParams.AddIgnoredActor(Causer);
+
+			FHitResult Hit;
+			if (World->SweepSingleByObjectType(Hit, Start, End, FQuat::Identity, PawnQueryParams, FCollisionShape::MakeSphere(Radii[Index]), QueryParams))
+			{
+				OnProjectileHit(Index, Hit);
+				RemoveProjectile(Index);
+				continue;
+			}
+		}
+
+		if (bReachesWall)
+		{
+			OnProjectileHit(Index, WallHits[Index]);
+			RemoveProjectile(Index);
+			continue;
+		}
+		Positions[Index] = End;
+	}
+}
+
+void AAuraProjectileManager::OnProjectileHit(int32 Index, const FHitResult& Hit)
+{
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		const AAuraProjectile* ProjectileCDO = ProjectileClasses[Index]->GetDefaultObject<AAuraProjectile>();
+		UGameplayStatics::PlaySoundAtLocation(this, ProjectileCDO->GetImpactSound(), Hit.Location, FRotator::ZeroRotator);
+		UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, ProjectileCDO->GetImpactEffect(), Hit.Location);
+	}
+
+	if (HasAuthority() && DamageEffectSpecHandles[Index].Data.IsValid())
+	{
+		if (UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Hit.GetActor()))
+		{
+			TargetASC->ApplyGameplayEffectSpecToSelf(*DamageEffectSpecHandles[Index].Data.Get());
+		}
+	}
+}
+
+void AAuraProjectileManager::UpdateVisuals()
+{
+	for (TTuple<UClass*, TArray<FVector>>& Pair : VisualPositions)
+	{
+		Pair.Value.Reset();
+	}
+	for (int32 Index = 0; Index < Positions.Num(); ++Index)
+	{
+		VisualPositions.FindOrAdd(ProjectileClasses[Index]).Add(Positions[Index]);
+	}
+
+	for (const TTuple<UClass*, TArray<FVector>>& Pair : VisualPositions)
+	{
+		TObjectPtr<UNiagaraComponent>& VisualComponent = VisualComponents.FindOrAdd(Pair.Key);
+		if (VisualComponent == nullptr)
+		{
+			UNiagaraSystem* VisualSystem = Pair.Key->GetDefaultObject<AAuraProjectile>()->GetBatchedVisualSystem();
+			if (VisualSystem == nullptr) continue;
+
+			VisualComponent = UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, VisualSystem, FVector::ZeroVector, FRotator::ZeroRotator, FVector(1.f), false, true, ENCPoolMethod::None);
+			if (VisualComponent == nullptr) continue;
+		}
+		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(VisualComponent, AuraBatchedProjectiles::PositionsParameterName, Pair.Value);
+	}
+}
@@ -0,0 +1,32 @@
+
+#include "Actor/AuraProjectileManagerSubsystem.h"
+#include "Actor/AuraProjectileManager.h"
+
+AAuraProjectileManager* UAuraProjectileManagerSubsystem::GetProjectileManager()
+{
+	if (ProjectileManager == nullptr && GetWorld()->GetNetMode() != NM_Client)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ProjectileManager = GetWorld()->SpawnActor<AAuraProjectileManager>(SpawnParams);
+	}
+	return ProjectileManager;
+}
+
+void UAuraProjectileManagerSubsystem::RegisterProjectileManager(AAuraProjectileManager* InProjectileManager)
+{
+	ProjectileManager = InProjectileManager;
+}
+
+void UAuraProjectileManagerSubsystem::UnregisterProjectileManager(AAuraProjectileManager* InProjectileManager)
+{
+	if (ProjectileManager == InProjectileManager)
+	{
+		ProjectileManager = nullptr;
+	}
+}
+
+bool UAuraProjectileManagerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
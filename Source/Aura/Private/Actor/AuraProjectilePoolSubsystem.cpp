@@ -0,0 +1,99 @@
+
+#include "Actor/AuraProjectilePoolSubsystem.h"
+#include "Actor/AuraProjectile.h"
+#include "Aura/Aura.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Projectiles Spawned"), STAT_AuraPooledProjectilesSpawned, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Projectiles Reused"), STAT_AuraPooledProjectilesReused, STATGROUP_Aura);
+
+void UAuraProjectilePoolSubsystem::Deinitialize()
+{
+	Pools.Empty();
+	Super::Deinitialize();
+}
+
+bool UAuraProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAuraProjectilePoolSubsystem::Prewarm(TSubclassOf<AAuraProjectile> ProjectileClass, int32 Count)
+{
+	if (ProjectileClass == nullptr || GetWorld()->GetNetMode() == NM_Client) return;
+
+	FAuraProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass);
+	while (Pool.NumSpawned < Count)
+	{
+		AAuraProjectile* Projectile = SpawnPooledProjectile(ProjectileClass, Pool);
+		Pool.InactiveProjectiles.Add(Projectile);
+	}
+}
+
+AAuraProjectile* UAuraProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<AAuraProjectile> ProjectileClass, AActor* Owner, APawn* Instigator)
+{
+	if (ProjectileClass == nullptr) return nullptr;
+
+	FAuraProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass);
+
+	AAuraProjectile* Projectile = nullptr;
+	while (Pool.InactiveProjectiles.Num() > 0 && !IsValid(Projectile))
+	{
+		Projectile = Pool.InactiveProjectiles.Pop(EAllowShrinking::No);
+	}
+
+	if (IsValid(Projectile))
+	{
+		INC_DWORD_STAT(STAT_AuraPooledProjectilesReused);
+	}
+	else
+	{
+		Projectile = SpawnPooledProjectile(ProjectileClass, Pool);
+	}
+
+	Projectile->SetOwner(Owner);
+	Projectile->SetInstigator(Instigator);
+	return Projectile;
+}
+
+void UAuraProjectilePoolSubsystem::ReleaseProjectile(AAuraProjectile* Projectile)
+{
+	if (!IsValid(Projectile) || !Projectile->IsActive()) return;
+
+	Projectile->DeactivatePooled();
+	Pools.FindOrAdd(Projectile->GetClass()).InactiveProjectiles.Add(Projectile);
+}
+
+AAuraProjectile* UAuraProjectilePoolSubsystem::SpawnPooledProjectile(TSubclassOf<AAuraProjectile> ProjectileClass, FAuraProjectilePool& Pool)
+{
+	const FTransform PoolTransform;
+	AAuraProjectile* Projectile = GetWorld()->SpawnActorDeferred<AAuraProjectile>(
+		ProjectileClass,
+		PoolTransform,
+		nullptr,
+		nullptr,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn
+		);
+
+	// Spawned inactive and dormant, ActivatePooled wakes it up.
+	Projectile->bPooled = true;
+	Projectile->Activation.bActive = false;
+	Projectile->NetDormancy = DORM_DormantAll;
+	Projectile->FinishSpawning(PoolTransform);
+
+	// Level streaming or gameplay code may still destroy pooled projectiles
+	Projectile->OnDestroyed.AddDynamic(this, &ThisClass::OnPooledProjectileDestroyed);
+
+	Pool.NumSpawned++;
+	INC_DWORD_STAT(STAT_AuraPooledProjectilesSpawned);
+	return Projectile;
+}
+
+void UAuraProjectilePoolSubsystem::OnPooledProjectileDestroyed(AActor* DestroyedActor)
+{
+	FAuraProjectilePool* Pool = Pools.Find(DestroyedActor->GetClass());
+	if (Pool == nullptr) return;
+
+	Pool->InactiveProjectiles.RemoveSingleSwap(Cast<AAuraProjectile>(DestroyedActor), EAllowShrinking::No);
+	Pool->NumSpawned--;
+	DEC_DWORD_STAT(STAT_AuraPooledProjectilesSpawned);
+}
@@ -1,13 +1,269 @@
 ﻿
 #include "AuraAbilityTypes.h"
+#include "Aura/Aura.h"
+#include "Engine/NetSerialization.h"
+#include "Serialization/BitWriter.h"
+#include "HAL/IConsoleManager.h"
+#include "Containers/LockFreeList.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Effect Contexts Sent"), STAT_AuraEffectContextsSent, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Effect Context Bits Sent"), STAT_AuraEffectContextBitsSent, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Effect Contexts"), STAT_AuraLiveEffectContexts, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Peak Effect Contexts"), STAT_AuraPeakEffectContexts, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Effect Context Hit Results"), STAT_AuraLiveEffectContextHitResults, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Peak Effect Context Hit Results"), STAT_AuraPeakEffectContextHitResults, STATGROUP_Aura);
+
+static TAutoConsoleVariable<bool> CVarAuraCompactHitResult(
+	TEXT("Aura.Net.CompactHitResult"),
+	false,
+	TEXT("Replicates effect context hit results as quantized impact point, impact normal and hit actor instead of the full FHitResult.\n")
+	TEXT("Drops TraceStart/End, Component, BoneName and PhysMaterial on clients, only enable when no cue or ability reads them."));
+
+// Bit 5 sends the full FHitResult, bit 10 the compact one.
+static constexpr int32 NumRepBits = 11;
+
+/*
+ * Free lists for contexts and their hit results. Freed blocks are kept for reuse rather than returned to the general
+ * allocator, so steady state combat allocates nothing. Both lists are lock free, contexts are created on any thread.
+ * The pools are leaked on purpose: contexts held by the engine can outlive static destruction.
+ */
+namespace AuraEffectContextPool
+{
+	/*
+	 * Fixed size blocks carved out of chunks the pool allocates itself. Owns() tells them apart from memory the engine
+	 * allocated for a context on its own (NetSerialize, script struct copies), which has to go back to FMemory::Free.
+	 * Once every chunk is in use Allocate returns nullptr and callers fall back to FMemory.
+	 */
+	template<SIZE_T ElementSize>
+	class TChunkedPool
+	{
+	public:
+
+		void* Allocate()
+		{
+			if (void* Block = FreeList.Pop())
+			{
+				return Block;
+			}
+			return AllocateChunk();
+		}
+
+		void Free(void* Block)
+		{
+			FreeList.Push(Block);
+		}
+
+		bool Owns(const void* Block) const
+		{
+			const UPTRINT Address = reinterpret_cast<UPTRINT>(Block);
+			const int32 NumAllocatedChunks = NumChunks.load(std::memory_order_acquire);
+			for (int32 ChunkIndex = 0; ChunkIndex < NumAllocatedChunks; ++ChunkIndex)
+			{
+				const UPTRINT ChunkStart = Chunks[ChunkIndex].load(std::memory_order_relaxed);
+				if (Address >= ChunkStart && Address < ChunkStart + ChunkSize)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+	private:
+
+		static constexpr SIZE_T BlockSize = Align(ElementSize, PLATFORM_CACHE_LINE_SIZE);
+		static constexpr int32 BlocksPerChunk = 256;
+		static constexpr int32 MaxChunks = 64;
+		static constexpr SIZE_T ChunkSize = BlockSize * BlocksPerChunk;
+
+		void* AllocateChunk()
+		{
+			FScopeLock Lock(&ChunkCriticalSection);
+
+			// Another thread may have added a chunk while this one waited
+			if (void* Block = FreeList.Pop())
+			{
+				return Block;
+			}
+
+			const int32 ChunkIndex = NumChunks.load(std::memory_order_relaxed);
+			if (ChunkIndex == MaxChunks)
+			{
+				return nullptr;
+			}
+
+			uint8* Chunk = static_cast<uint8*>(FMemory::Malloc(ChunkSize, PLATFORM_CACHE_LINE_SIZE));
+			Chunks[ChunkIndex].store(reinterpret_cast<UPTRINT>(Chunk), std::memory_order_relaxed);
+			NumChunks.store(ChunkIndex + 1, std::memory_order_release);
+
+			for (int32 BlockIndex = 1; BlockIndex < BlocksPerChunk; ++BlockIndex)
+			{
+				FreeList.Push(Chunk + BlockIndex * BlockSize);
+			}
+			return Chunk;
+		}
+
+		TLockFreePointerListUnordered<void, PLATFORM_CACHE_LINE_SIZE> FreeList;
+		std::atomic<UPTRINT> Chunks[MaxChunks] = {};
+		std::atomic<int32> NumChunks = 0;
+		FCriticalSection ChunkCriticalSection;
+	};
+
+	using FContextPool = TChunkedPool<sizeof(FAuraGameplayEffectContext)>;
+	using FHitResultPool = TChunkedPool<sizeof(FHitResult)>;
+
+	static FContextPool& GetContextPool()
+	{
+		static FContextPool& Pool = *new FContextPool();
+		return Pool;
+	}
+
+	static FHitResultPool& GetHitResultPool()
+	{
+		static FHitResultPool& Pool = *new FHitResultPool();
+		return Pool;
+	}
+
+#if STATS
+	static std::atomic<int32> NumLiveContexts = 0;
+	static std::atomic<int32> NumPeakContexts = 0;
+	static std::atomic<int32> NumLiveHitResults = 0;
+	static std::atomic<int32> NumPeakHitResults = 0;
+
+	static void TrackAlloc(std::atomic<int32>& NumLive, std::atomic<int32>& NumPeak, TStatId LiveStat, TStatId PeakStat)
+	{
+		const int32 Live = ++NumLive;
+		int32 Peak = NumPeak.load();
+		while (Live > Peak && !NumPeak.compare_exchange_weak(Peak, Live)) {}
+		SET_DWORD_STAT_FName(LiveStat.GetName(), Live);
+		SET_DWORD_STAT_FName(PeakStat.GetName(), FMath::Max(Live, Peak));
+	}
+
+	static void TrackFree(std::atomic<int32>& NumLive, TStatId LiveStat)
+	{
+		SET_DWORD_STAT_FName(LiveStat.GetName(), --NumLive);
+	}
+#endif
+
+	static TSharedPtr<FHitResult> MakeHitResult(const FHitResult& InHitResult)
+	{
+#if STATS
+		TrackAlloc(NumLiveHitResults, NumPeakHitResults, GET_STATID(STAT_AuraLiveEffectContextHitResults), GET_STATID(STAT_AuraPeakEffectContextHitResults));
+#endif
+		void* Block = GetHitResultPool().Allocate();
+		FHitResult* PooledHitResult = new (Block ? Block : FMemory::Malloc(sizeof(FHitResult), alignof(FHitResult))) FHitResult(InHitResult);
+		return TSharedPtr<FHitResult>(PooledHitResult, [](FHitResult* HitResult)
+		{
+			HitResult->~FHitResult();
+			if (GetHitResultPool().Owns(HitResult))
+			{
+				GetHitResultPool().Free(HitResult);
+			}
+			else
+			{
+				FMemory::Free(HitResult);
+			}
+#if STATS
+			TrackFree(NumLiveHitResults, GET_STATID(STAT_AuraLiveEffectContextHitResults));
+#endif
+		});
+	}
+}
+
+FAuraEffectContextLiveCounter::FAuraEffectContextLiveCounter()
+{
+#if STATS
+	AuraEffectContextPool::TrackAlloc(AuraEffectContextPool::NumLiveContexts, AuraEffectContextPool::NumPeakContexts, GET_STATID(STAT_AuraLiveEffectContexts), GET_STATID(STAT_AuraPeakEffectContexts));
+#endif
+}
+
+FAuraEffectContextLiveCounter::FAuraEffectContextLiveCounter(const FAuraEffectContextLiveCounter&)
+	: FAuraEffectContextLiveCounter()
+{
+}
+
+FAuraEffectContextLiveCounter::~FAuraEffectContextLiveCounter()
+{
+#if STATS
+	AuraEffectContextPool::TrackFree(AuraEffectContextPool::NumLiveContexts, GET_STATID(STAT_AuraLiveEffectContexts));
+#endif
+}
+
+void* FAuraGameplayEffectContext::operator new(size_t Size)
+{
+	// Types deriving from this context, and an exhausted pool, fall back to the general allocator.
+	if (Size == sizeof(FAuraGameplayEffectContext))
+	{
+		if (void* Block = AuraEffectContextPool::GetContextPool().Allocate())
+		{
+			return Block;
+		}
+	}
+	return FMemory::Malloc(Size);
+}
+
+void FAuraGameplayEffectContext::operator delete(void* Ptr, size_t Size)
+{
+	if (Ptr == nullptr) return;
+
+	// Contexts the engine built in place on its own FMemory block end here too, only pool blocks go back to the pool.
+	if (AuraEffectContextPool::GetContextPool().Owns(Ptr))
+	{
+		AuraEffectContextPool::GetContextPool().Free(Ptr);
+	}
+	else
+	{
+		FMemory::Free(Ptr);
+	}
+}
 
 UScriptStruct* FAuraGameplayEffectContext::GetScriptStruct() const
 {
-	return FGameplayEffectContext::GetScriptStruct();
+	return StaticStruct();
+}
+
+float FAuraGameplayEffectContext::RollCombatRandom(uint32 RollIndex) const
+{
+	if (CombatSeed == 0)
+	{
+		return FMath::FRand();
+	}
+
+	// splitmix64 over seed and index, adjacent indices give independent rolls
+	uint64 Mixed = (static_cast<uint64>(static_cast<uint32>(CombatSeed)) << 32 | RollIndex) + 0x9E3779B97F4A7C15ull;
+	Mixed = (Mixed ^ (Mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+	Mixed = (Mixed ^ (Mixed >> 27)) * 0x94D049BB133111EBull;
+	Mixed ^= Mixed >> 31;
+
+	// Top 24 bits, exactly representable as a float in [0, 1)
+	return static_cast<float>(Mixed >> 40) * (1.f / 16777216.f);
+}
+
+void FAuraGameplayEffectContext::AddHitResult(const FHitResult& InHitResult, bool bReset)
+{
+	if (bReset && HitResult.IsValid())
+	{
+		HitResult.Reset();
+		bHasWorldOrigin = false;
+	}
+
+	check(!HitResult.IsValid());
+	HitResult = AuraEffectContextPool::MakeHitResult(InHitResult);
+	if (bHasWorldOrigin == false)
+	{
+		AddOrigin(InHitResult.TraceStart);
+	}
 }
 
 bool FAuraGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
+#if STATS
+	// Replication saves through FNetBitWriter, which doesn't implement Tell, so count its bits.
+	FBitWriter* BitWriter = Ar.IsSaving() && Ar.IsNetArchive() ? static_cast<FBitWriter*>(&Ar) : nullptr;
+	const int64 StartBits = BitWriter ? BitWriter->GetNumBits() : 0;
+#endif
+
 	uint32 RepBits = 0;
 	if (Ar.IsSaving())
 	{
@@ -33,7 +289,7 @@ bool FAuraGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* M
 		}
 		if (HitResult.IsValid())
 		{
-			RepBits |= 1 << 5;
+			RepBits |= CVarAuraCompactHitResult.GetValueOnAnyThread() ? (1 << 10) : (1 << 5);
 		}
 		if (bHasWorldOrigin)
 		{
@@ -47,9 +303,13 @@ bool FAuraGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* M
 		{
 			RepBits |= 1 << 8;
 		}
+		if (CombatSeed != 0)
+		{
+			RepBits |= 1 << 9;
+		}
 	}
 
-	Ar.SerializeBits(&RepBits, 9);
+	Ar.SerializeBits(&RepBits, NumRepBits);
 
 	if (RepBits & (1 << 0))
 	{
@@ -71,39 +331,82 @@ bool FAuraGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* M
 	{
 		SafeNetSerializeTArray_Default<31>(Ar, Actors);
 	}
-	if (RepBits & (1 << 5))
+	if (RepBits & ((1 << 5) | (1 << 10)))
 	{
 		if (Ar.IsLoading())
 		{
 			if (!HitResult.IsValid())
 			{
-				HitResult = TSharedPtr<FHitResult>(new FHitResult());
+				HitResult = AuraEffectContextPool::MakeHitResult(FHitResult());
 			}
 		}
-		HitResult->NetSerialize(Ar, Map, bOutSuccess);
+		if (RepBits & (1 << 10))
+		{
+			NetSerializeCompactHitResult(Ar, Map, bOutSuccess);
+		}
+		else
+		{
+			HitResult->NetSerialize(Ar, Map, bOutSuccess);
+		}
 	}
 	if (RepBits & (1 << 6))
 	{
-		Ar << WorldOrigin;
+		FVector_NetQuantize QuantizedWorldOrigin = WorldOrigin;
+		QuantizedWorldOrigin.NetSerialize(Ar, Map, bOutSuccess);
+		WorldOrigin = QuantizedWorldOrigin;
 		bHasWorldOrigin = true;
 	}
 	else
 	{
 		bHasWorldOrigin = false;
 	}
-	if (RepBits & (1 << 7))
+
+	// Los flags viajan solo en los RepBits
+	bIsBlockedHit = (RepBits & (1 << 7)) != 0;
+	bIsCriticalHit = (RepBits & (1 << 8)) != 0;
+
+	if (RepBits & (1 << 9))
 	{
-		Ar << bIsBlockedHit;
+		Ar << CombatSeed;
 	}
-	if (RepBits & (1 << 8))
+	else
 	{
-		Ar << bIsCriticalHit;
+		CombatSeed = 0;
 	}
 	if (Ar.IsLoading())
 	{
 		AddInstigator(Instigator.Get(), EffectCauser.Get()); // Just to initialize InstigatorAbilitySystemComponent
 	}	
+
+#if STATS
+	if (BitWriter)
+	{
+		INC_DWORD_STAT(STAT_AuraEffectContextsSent);
+		INC_DWORD_STAT_BY(STAT_AuraEffectContextBitsSent, BitWriter->GetNumBits() - StartBits);
+	}
+#endif
 	
 	bOutSuccess = true;
 	return true;
 }
+
+void FAuraGameplayEffectContext::NetSerializeCompactHitResult(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	FVector_NetQuantize ImpactPoint = HitResult->ImpactPoint;
+	FVector_NetQuantizeNormal ImpactNormal = HitResult->ImpactNormal;
+	AActor* HitActor = HitResult->GetActor();
+
+	ImpactPoint.NetSerialize(Ar, Map, bOutSuccess);
+	ImpactNormal.NetSerialize(Ar, Map, bOutSuccess);
+	Ar << HitActor;
+
+	if (Ar.IsLoading())
+	{
+		HitResult->bBlockingHit = true;
+		HitResult->ImpactPoint = ImpactPoint;
+		HitResult->Location = ImpactPoint;
+		HitResult->ImpactNormal = ImpactNormal;
+		HitResult->Normal = ImpactNormal;
+		HitResult->HitObjectHandle = FActorInstanceHandle(HitActor);
+	}
+}
@@ -3,6 +3,15 @@
 #include "GameplayEffectTypes.h"
 #include "AuraAbilityTypes.generated.h"
 
+/** Counts live contexts for stat Aura in its constructors and destructor, so every way of creating a context is tracked the same. */
+struct FAuraEffectContextLiveCounter
+{
+	FAuraEffectContextLiveCounter();
+	FAuraEffectContextLiveCounter(const FAuraEffectContextLiveCounter&);
+	~FAuraEffectContextLiveCounter();
+	FAuraEffectContextLiveCounter& operator=(const FAuraEffectContextLiveCounter&) { return *this; }
+};
+
 USTRUCT(NotBlueprintType)
 struct FAuraGameplayEffectContext : public FGameplayEffectContext
 {
@@ -14,11 +23,22 @@ protected:
 	bool bIsBlockedHit = false;
 	UPROPERTY()
 	bool bIsCriticalHit = false;
+	/** Seed for block/crit rolls, set by the server when it makes the damage spec. 0 means unseeded. */
+	UPROPERTY()
+	int32 CombatSeed = 0;
 
 public:
 
+	/** Contexts come from a thread-safe pool instead of the general allocator, blocks the engine allocated go back to FMemory. See AuraAbilityTypes.cpp. */
+	static void* operator new(size_t Size);
+	static void* operator new(size_t Size, void* Ptr) { return Ptr; }
+	static void operator delete(void* Ptr, size_t Size);
+	static void operator delete(void* Ptr, void* Place) {}
+
 	virtual UScriptStruct* GetScriptStruct() const override;
 	virtual bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess) override;
+	/** Same as the base version, but the hit result copy comes from the pooled allocator. */
+	virtual void AddHitResult(const FHitResult& InHitResult, bool bReset = false) override;
 	/** Creates a copy of this context, used to duplicate for later modifications */
 	virtual FAuraGameplayEffectContext* Duplicate() const override
 	{
@@ -36,6 +56,22 @@ public:
 	bool IsBlockedHit() const { return bIsBlockedHit; }
 	void SetIsCriticalHit(bool bInIsCriticalHit){bIsCriticalHit = bInIsCriticalHit;}
 	void SetIsBlockedHit(bool bInIsBlockedHit){bIsBlockedHit = bInIsBlockedHit;}
+
+	int32 GetCombatSeed() const { return CombatSeed; }
+	void SetCombatSeed(int32 InCombatSeed) { CombatSeed = InCombatSeed; }
+
+	/**
+	 * Value in [0, 1) that only depends on CombatSeed and RollIndex. Falls back to FMath::FRand when unseeded.
+	 * Roll indices are built from replicated data only (see AuraDamage::GetRollIndex), so a client holding this context rolls the same.
+	 */
+	float RollCombatRandom(uint32 RollIndex) const;
+
+private:
+
+	FAuraEffectContextLiveCounter LiveCounter;
+
+	/** Impact point, impact normal and hit actor only, quantized. Enough for hit reacts and impact cues. */
+	void NetSerializeCompactHitResult(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
 };
 
 template<>
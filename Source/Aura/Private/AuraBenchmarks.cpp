@@ -0,0 +1,439 @@
+
+#include "Aura/Aura.h"
+
+/*
+ * Console benchmarks for the server hot paths. None of this ships, results go to LogAuraBenchmark.
+ */
+
+#if !UE_BUILD_SHIPPING
+
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "AuraAbilityTypes.h"
+#include "AuraGameplayTags.h"
+#include "AbilitySystem/AuraAbilitySystemLibrary.h"
+#include "AbilitySystem/AuraAttributeSet.h"
+#include "AbilitySystem/ExecCalc/ExecCalc_Damage.h"
+#include "Actor/AuraProjectile.h"
+#include "Actor/AuraProjectileManager.h"
+#include "Actor/AuraProjectileManagerSubsystem.h"
+#include "Character/AuraEnemy.h"
+#include "EngineUtils.h"
+#include "GameplayEffect.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+#include "TimerManager.h"
+#include "UObject/CoreNet.h"
+
+/*
+ * Attribute replication benchmark: spawns NumEnemies copies of the first enemy in the level around it, waits Seconds and
+ * logs the bytes sent to every client connection in that window. Run it on the server, with clients connected and looking
+ * at the arena, once per build to compare.
+ */
+static FAutoConsoleCommandWithWorldAndArgs CmdAuraNetAttributeBenchmark(
+	TEXT("Aura.Net.AttributeBenchmark"),
+	TEXT("Server only. Arguments: NumEnemies (default 100), Seconds (default 10). Logs bytes per second sent to each connection."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+		if (NetDriver == nullptr || !NetDriver->IsServer())
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Net.AttributeBenchmark: needs a server world with a net driver"));
+			return;
+		}
+
+		const int32 NumEnemies = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+		const float Seconds = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 1.f) : 10.f;
+
+		TActorIterator<AAuraEnemy> EnemyIt(World);
+		if (!EnemyIt)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Net.AttributeBenchmark: no AAuraEnemy in the level to copy"));
+			return;
+		}
+		const AAuraEnemy* Template = *EnemyIt;
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		// Cuadricula alrededor del enemigo original
+		const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumEnemies)));
+		const FVector GridOrigin = Template->GetActorLocation() - FVector(GridSize * 100.f, GridSize * 100.f, 0.f);
+		TArray<TWeakObjectPtr<AActor>> SpawnedEnemies;
+		for (int32 Index = 0; Index < NumEnemies; ++Index)
+		{
+			const FVector Location = GridOrigin + FVector((Index % GridSize) * 200.f, (Index / GridSize) * 200.f, 0.f);
+			if (AAuraEnemy* Enemy = World->SpawnActor<AAuraEnemy>(Template->GetClass(), Location, Template->GetActorRotation(), SpawnParams))
+			{
+				if (Enemy->GetController() == nullptr)
+				{
+					Enemy->SpawnDefaultController();
+				}
+				SpawnedEnemies.Add(Enemy);
+			}
+		}
+
+		TMap<TWeakObjectPtr<UNetConnection>, int64> StartBytes;
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			StartBytes.Add(Connection, Connection->OutTotalBytes);
+		}
+
+		UE_LOG(LogAuraBenchmark, Display, TEXT("Aura.Net.AttributeBenchmark: %d enemies spawned, measuring %.1f s over %d connections"), SpawnedEnemies.Num(), Seconds, StartBytes.Num());
+
+		const TWeakObjectPtr<UNetDriver> WeakNetDriver = NetDriver;
+		FTimerHandle TimerHandle;
+		World->GetTimerManager().SetTimer(TimerHandle, FTimerDelegate::CreateLambda([WeakNetDriver, StartBytes, SpawnedEnemies, Seconds]()
+		{
+			if (WeakNetDriver.IsValid())
+			{
+				for (const TPair<TWeakObjectPtr<UNetConnection>, int64>& Start : StartBytes)
+				{
+					if (const UNetConnection* Connection = Start.Key.Get())
+					{
+						const int64 BytesSent = static_cast<int64>(Connection->OutTotalBytes) - Start.Value;
+						UE_LOG(LogAuraBenchmark, Display, TEXT("Aura.Net.AttributeBenchmark: %s %lld bytes, %.0f bytes/s"),
+							*Connection->LowLevelGetRemoteAddress(true), BytesSent, BytesSent / Seconds);
+					}
+				}
+			}
+			for (const TWeakObjectPtr<AActor>& Enemy : SpawnedEnemies)
+			{
+				if (Enemy.IsValid())
+				{
+					Enemy->Destroy();
+				}
+			}
+		}), Seconds, false);
+	}));
+
+/*
+ * N single applications vs. one batch: player 0 damages every enemy in the level with an instant effect that only runs
+ * UExecCalc_Damage, first with one ApplyGameplayEffectSpecToSelf per enemy, then through ApplyDamageEffectToTargets.
+ * Health is restored after every iteration, outside of the timed sections.
+ */
+static FAutoConsoleCommandWithWorldAndArgs CmdAuraDamageBatchBenchmark(
+	TEXT("Aura.Damage.BatchBenchmark"),
+	TEXT("Server only. Damages every enemy in the level from player 0, one application per enemy and then as one batch. Optional argument: iterations (default 10)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Damage.BatchBenchmark: needs a server or standalone world"));
+			return;
+		}
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10;
+
+		UAbilitySystemComponent* SourceASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(UGameplayStatics::GetPlayerPawn(World, 0));
+		if (SourceASC == nullptr)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Damage.BatchBenchmark: player 0 has no ability system component"));
+			return;
+		}
+
+		TArray<AActor*> Targets;
+		TArray<UAbilitySystemComponent*> TargetASCs;
+		TArray<float> StartHealth;
+		for (TActorIterator<AAuraEnemy> EnemyIt(World); EnemyIt; ++EnemyIt)
+		{
+			if (UAbilitySystemComponent* TargetASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(*EnemyIt))
+			{
+				Targets.Add(*EnemyIt);
+				TargetASCs.Add(TargetASC);
+				StartHealth.Add(TargetASC->GetNumericAttributeBase(UAuraAttributeSet::GetHealthAttribute()));
+			}
+		}
+		if (Targets.Num() == 0)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Damage.BatchBenchmark: no AAuraEnemy in the level"));
+			return;
+		}
+
+		// Same shape as the damage abilities' effects: instant, only the damage execution.
+		UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage());
+		DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+		DamageEffect->Executions.AddDefaulted_GetRef().CalculationClass = UExecCalc_Damage::StaticClass();
+
+		const FGameplayEffectSpecHandle SpecHandle(new FGameplayEffectSpec(DamageEffect, SourceASC->MakeEffectContext(), 1.f));
+		for (const TPair<FGameplayTag, FGameplayTag>& Pair : FAuraGameplayTags::Get().DamageTypesToResistances)
+		{
+			// Every damage type, so every resistance is evaluated
+			SpecHandle.Data->SetSetByCallerMagnitude(Pair.Key, 1.f);
+		}
+
+		auto RestoreHealth = [&TargetASCs, &StartHealth]()
+		{
+			for (int32 Index = 0; Index < TargetASCs.Num(); ++Index)
+			{
+				if (IsValid(TargetASCs[Index]))
+				{
+					TargetASCs[Index]->SetNumericAttributeBase(UAuraAttributeSet::GetHealthAttribute(), StartHealth[Index]);
+				}
+			}
+		};
+
+		double SingleTime = 0.0;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			for (UAbilitySystemComponent* TargetASC : TargetASCs)
+			{
+				TargetASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data);
+			}
+			SingleTime += FPlatformTime::Seconds() - StartTime;
+			RestoreHealth();
+		}
+
+		double BatchTime = 0.0;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			UAuraAbilitySystemLibrary::ApplyDamageEffectToTargets(SpecHandle, Targets);
+			BatchTime += FPlatformTime::Seconds() - StartTime;
+			RestoreHealth();
+		}
+
+		UE_LOG(LogAuraBenchmark, Display, TEXT("Aura.Damage.BatchBenchmark %d targets, %d iterations: single %.3f ms (%.2f us/target), batch %.3f ms (%.2f us/target)"),
+			Targets.Num(), Iterations,
+			SingleTime * 1000.0 / Iterations, SingleTime * 1000000.0 / (Iterations * Targets.Num()),
+			BatchTime * 1000.0 / Iterations, BatchTime * 1000000.0 / (Iterations * Targets.Num()));
+	}));
+
+/*
+ * Bits per damage event for the effect context: a context like the one a projectile hit sends (instigator, causer,
+ * source object, hit result, origin, blocked and critical flags, seed) serialized with the engine's
+ * FGameplayEffectContext::NetSerialize, with ours and the full hit result, and with ours and Aura.Net.CompactHitResult.
+ * Objects are serialized through the first client connection's package map, twice, so NetGUID exports aren't counted.
+ */
+static FAutoConsoleCommandWithWorldAndArgs CmdAuraNetEffectContextBenchmark(
+	TEXT("Aura.Net.EffectContextBenchmark"),
+	TEXT("Server only, with a client connected. Logs the bits one damage effect context takes on the wire with each serialization."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+		if (NetDriver == nullptr || !NetDriver->IsServer() || NetDriver->ClientConnections.Num() == 0)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Net.EffectContextBenchmark: needs a server world with a client connected"));
+			return;
+		}
+		UPackageMap* PackageMap = NetDriver->ClientConnections[0]->PackageMap;
+
+		APawn* SourcePawn = UGameplayStatics::GetPlayerPawn(World, 0);
+		UAbilitySystemComponent* SourceASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(SourcePawn);
+		TActorIterator<AAuraEnemy> EnemyIt(World);
+		if (SourceASC == nullptr || !EnemyIt)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Net.EffectContextBenchmark: needs player 0 with an ability system component and an AAuraEnemy in the level"));
+			return;
+		}
+		AAuraEnemy* Target = *EnemyIt;
+
+		FGameplayEffectContextHandle ContextHandle = SourceASC->MakeEffectContext();
+		ContextHandle.AddSourceObject(SourcePawn);
+		FHitResult HitResult(Target, nullptr, Target->GetActorLocation(), FVector::UpVector);
+		HitResult.TraceStart = SourcePawn->GetActorLocation();
+		HitResult.TraceEnd = Target->GetActorLocation();
+		ContextHandle.AddHitResult(HitResult, true);
+		UAuraAbilitySystemLibrary::SetIsBlockedHit(ContextHandle, true);
+		UAuraAbilitySystemLibrary::SetIsCriticalHit(ContextHandle, true);
+		UAuraAbilitySystemLibrary::SetCombatSeed(ContextHandle, 0x5EED);
+		FAuraGameplayEffectContext* Context = static_cast<FAuraGameplayEffectContext*>(ContextHandle.Get());
+
+		auto MeasureBits = [PackageMap](TFunctionRef<void(FArchive&, bool&)> Serialize)
+		{
+			int64 NumBits = 0;
+			for (int32 Pass = 0; Pass < 2; ++Pass)
+			{
+				FNetBitWriter Writer(PackageMap, 8192);
+				bool bOutSuccess = true;
+				Serialize(Writer, bOutSuccess);
+				NumBits = Writer.GetNumBits();
+			}
+			return NumBits;
+		};
+
+		const int64 EngineBits = MeasureBits([Context, PackageMap](FArchive& Ar, bool& bOutSuccess)
+		{
+			Context->FGameplayEffectContext::NetSerialize(Ar, PackageMap, bOutSuccess);
+		});
+
+		IConsoleVariable* CompactHitResult = IConsoleManager::Get().FindConsoleVariable(TEXT("Aura.Net.CompactHitResult"));
+		const bool bWasCompact = CompactHitResult && CompactHitResult->GetBool();
+
+		auto AuraSerialize = [Context, PackageMap](FArchive& Ar, bool& bOutSuccess)
+		{
+			Context->NetSerialize(Ar, PackageMap, bOutSuccess);
+		};
+		if (CompactHitResult) CompactHitResult->Set(false, ECVF_SetByCode);
+		const int64 FullBits = MeasureBits(AuraSerialize);
+		if (CompactHitResult) CompactHitResult->Set(true, ECVF_SetByCode);
+		const int64 CompactBits = MeasureBits(AuraSerialize);
+		if (CompactHitResult) CompactHitResult->Set(bWasCompact, ECVF_SetByCode);
+
+		UE_LOG(LogAuraBenchmark, Display, TEXT("Aura.Net.EffectContextBenchmark per damage event: engine %lld bits (%.1f bytes), Aura %lld bits (%.1f bytes), Aura compact hit result %lld bits (%.1f bytes)"),
+			EngineBits, EngineBits / 8.0, FullBits, FullBits / 8.0, CompactBits, CompactBits / 8.0);
+	}));
+
+/*
+ * Batched projectile load: player 0 fires Count projectiles in evenly spread directions on the horizontal plane, then the
+ * manager is ticked at 30 Hz with every projectile swept against pawns each tick and with the pawn grid broadphase.
+ * Projectiles carry no damage. Each run is drained before the next, clients see both volleys fly.
+ */
+static FAutoConsoleCommandWithWorldAndArgs CmdAuraProjectilesLoadTest(
+	TEXT("Aura.Projectiles.LoadTest"),
+	TEXT("Server only. Arguments: projectile count (default 2000), ticks (default 60), projectile class path (default AAuraProjectile). Logs the game thread time of a manager tick without and with the pawn broadphase."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Projectiles.LoadTest: needs a server or standalone world"));
+			return;
+		}
+		const int32 Count = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 2000;
+		const int32 Ticks = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 60;
+		TSubclassOf<AAuraProjectile> ProjectileClass = Args.Num() > 2 ? LoadClass<AAuraProjectile>(nullptr, *Args[2]) : AAuraProjectile::StaticClass();
+
+		APawn* SourcePawn = UGameplayStatics::GetPlayerPawn(World, 0);
+		UAuraProjectileManagerSubsystem* ManagerSubsystem = World->GetSubsystem<UAuraProjectileManagerSubsystem>();
+		AAuraProjectileManager* ProjectileManager = ManagerSubsystem ? ManagerSubsystem->GetProjectileManager() : nullptr;
+		if (SourcePawn == nullptr || ProjectileManager == nullptr || ProjectileClass == nullptr)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Projectiles.LoadTest: needs player 0, a projectile manager and a valid projectile class"));
+			return;
+		}
+
+		IConsoleVariable* Broadphase = IConsoleManager::Get().FindConsoleVariable(TEXT("Aura.Projectiles.Broadphase"));
+		const bool bWasBroadphase = Broadphase == nullptr || Broadphase->GetBool();
+		constexpr float DeltaSeconds = 1.f / 30.f;
+
+		auto RunLoad = [&](bool bUseBroadphase)
+		{
+			if (Broadphase) Broadphase->Set(bUseBroadphase, ECVF_SetByCode);
+
+			const FVector Origin = SourcePawn->GetActorLocation();
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				const float Yaw = 360.f * Index / Count;
+				ProjectileManager->SpawnProjectile(ProjectileClass, Origin, FRotator(0.f, Yaw, 0.f).Vector(), 0.f, SourcePawn, FGameplayEffectSpecHandle());
+			}
+
+			// The first tick also sends the spawns, it isn't timed
+			ProjectileManager->Tick(DeltaSeconds);
+
+			double TickTime = 0.0;
+			for (int32 Tick = 0; Tick < Ticks; ++Tick)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				ProjectileManager->Tick(DeltaSeconds);
+				TickTime += FPlatformTime::Seconds() - StartTime;
+			}
+
+			for (int32 Tick = 0; Tick < 10000 && ProjectileManager->Num() > 0; ++Tick)
+			{
+				ProjectileManager->Tick(DeltaSeconds);
+			}
+			return TickTime;
+		};
+
+		const double SweepAllTime = RunLoad(false);
+		const double BroadphaseTime = RunLoad(true);
+		if (Broadphase) Broadphase->Set(bWasBroadphase, ECVF_SetByCode);
+
+		UE_LOG(LogAuraBenchmark, Display, TEXT("Aura.Projectiles.LoadTest %d projectiles of %s, %d ticks: sweep all %.3f ms/tick, pawn broadphase %.3f ms/tick"),
+			Count, *GetNameSafe(ProjectileClass), Ticks, SweepAllTime * 1000.0 / Ticks, BroadphaseTime * 1000.0 / Ticks);
+	}));
+
+/*
+ * Click to move paths: the query AAuraPlayerController::RequestClickToMovePath builds, from player 0's pawn to random
+ * reachable points. Synchronous queries report the game thread time the old blocking request cost; async ones report
+ * the game thread time to issue them and the latency until their callback, logged once every callback has arrived.
+ */
+static FAutoConsoleCommandWithWorldAndArgs CmdAuraNavClickToMovePathBenchmark(
+	TEXT("Aura.Nav.ClickToMovePathBenchmark"),
+	TEXT("Arguments: requests (default 100), radius (default 3000). Logs game thread time of synchronous click to move path queries, and game thread time and latency of async ones."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumRequests = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+		const float Radius = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 1.f) : 3000.f;
+
+		APawn* Pawn = UGameplayStatics::GetPlayerPawn(World, 0);
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		if (Pawn == nullptr || NavSys == nullptr)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Nav.ClickToMovePathBenchmark: needs player 0's pawn and a navigation system"));
+			return;
+		}
+
+		const FNavAgentProperties& AgentProperties = Pawn->GetNavAgentPropertiesRef();
+		const FVector Start = Pawn->GetNavAgentLocation();
+		const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProperties, Start);
+		if (NavData == nullptr)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Nav.ClickToMovePathBenchmark: no navigation data for player 0's pawn"));
+			return;
+		}
+
+		TArray<FVector> Destinations;
+		for (int32 Index = 0; Index < NumRequests; ++Index)
+		{
+			FNavLocation Destination;
+			if (NavSys->GetRandomReachablePointInRadius(Start, Radius, Destination))
+			{
+				Destinations.Add(Destination.Location);
+			}
+		}
+		if (Destinations.Num() == 0)
+		{
+			UE_LOG(LogAuraBenchmark, Warning, TEXT("Aura.Nav.ClickToMovePathBenchmark: no reachable point within %.0f"), Radius);
+			return;
+		}
+
+		double SyncTime = 0.0;
+		for (const FVector& Destination : Destinations)
+		{
+			const FPathFindingQuery Query(Pawn, *NavData, Start, Destination);
+			const double StartTime = FPlatformTime::Seconds();
+			NavSys->FindPathSync(AgentProperties, Query);
+			SyncTime += FPlatformTime::Seconds() - StartTime;
+		}
+
+		struct FAsyncResults
+		{
+			int32 NumRequests = 0;
+			double SyncTime = 0.0;
+			double IssueTime = 0.0;
+			TArray<double> Latencies;
+		};
+		TSharedRef<FAsyncResults> Results = MakeShared<FAsyncResults>();
+		Results->NumRequests = Destinations.Num();
+		Results->SyncTime = SyncTime;
+
+		for (const FVector& Destination : Destinations)
+		{
+			const FPathFindingQuery Query(Pawn, *NavData, Start, Destination);
+			const double RequestTime = FPlatformTime::Seconds();
+			NavSys->FindPathAsync(AgentProperties, Query, FNavPathQueryDelegate::CreateLambda([Results, RequestTime](uint32 PathId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+			{
+				Results->Latencies.Add(FPlatformTime::Seconds() - RequestTime);
+				if (Results->Latencies.Num() < Results->NumRequests) return;
+
+				double TotalLatency = 0.0;
+				double MaxLatency = 0.0;
+				for (const double Latency : Results->Latencies)
+				{
+					TotalLatency += Latency;
+					MaxLatency = FMath::Max(MaxLatency, Latency);
+				}
+				UE_LOG(LogAuraBenchmark, Display, TEXT("Aura.Nav.ClickToMovePathBenchmark %d paths: sync %.3f ms/path on the game thread, async %.3f ms/path on the game thread, latency %.3f ms average, %.3f ms max"),
+					Results->NumRequests, Results->SyncTime * 1000.0 / Results->NumRequests, Results->IssueTime * 1000.0 / Results->NumRequests,
+					TotalLatency * 1000.0 / Results->NumRequests, MaxLatency * 1000.0);
+			}));
+			Results->IssueTime += FPlatformTime::Seconds() - RequestTime;
+		}
+	}));
+
+#endif
@@ -1,52 +1,82 @@
-
 #include "AuraGameplayTags.h"
 #include "GameplayTagsManager.h"
+#include "HAL/IConsoleManager.h"
 
 FAuraGameplayTags FAuraGameplayTags::GameplayTags;
 
 void FAuraGameplayTags::InitializeNativeGameplayTags()
 {
-	GameplayTags.Attribute_Primary_Strength = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Primary.Strength"), FString("Increases physical damage"));
-	GameplayTags.Attribute_Primary_Intelligence = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Primary.Intelligence"), FString("Increases magical damage"));
-	GameplayTags.Attribute_Primary_Resilience = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Primary.Resilience"), FString("Increases armor an armor penetration"));
-	GameplayTags.Attribute_Primary_Vigor = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Primary.Vigor"), FString("Increases health"));
-
-	GameplayTags.Attribute_Secondary_Armor = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Secondary.Armor"), FString("Reduces damage taken, improves Block Chance"));
-	GameplayTags.Attribute_Secondary_ArmorPenetration = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Secondary.ArmorPenetration"), FString("ignores percentage of enemy armor, increases crit hit chance"));
-	GameplayTags.Attribute_Secondary_BlockChance = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Secondary.BlockChance"), FString("chance to cut incoming damage in half"));
-	GameplayTags.Attribute_Secondary_CriticalHitChance = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Secondary.CriticalHitChance"), FString("chance to double damage plus critical hit bonus"));
-	GameplayTags.Attribute_Secondary_CriticalHitDamage = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Secondary.CriticalHitDamage"), FString("bonus damage added when a critical hit is scored"));
-	GameplayTags.Attribute_Secondary_CriticalHitResistance = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Secondary.CriticalHitResistance"), FString("reduces critical hit chance of attacking enemies"));
-	GameplayTags.Attribute_Secondary_HealthRegeneration = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Secondary.HealthRegeneration"), FString("amount of health regenerated every on second"));
-	GameplayTags.Attribute_Secondary_ManaRegeneration = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Secondary.ManaRegeneration"), FString("amount of mana regenerated every on second"));
-	GameplayTags.Attribute_Secondary_MaxHealth = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Secondary.MaxHealth"), FString("maximum amount of health obtainable"));
-	GameplayTags.Attribute_Secondary_MaxMana = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Secondary.MaxMana"), FString("maximum amount of mana obtainable"));
-
-	GameplayTags.InputTag_LMB = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("InputTag_LMB"), FString("input tag for left mouse button "));
-	GameplayTags.InputTag_RMB = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("InputTag_RMB"), FString("input tag for right mouse button "));
-	GameplayTags.InputTag_1 = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("InputTag_1"), FString("input tag for number 1 "));
-	GameplayTags.InputTag_2 = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("InputTag_2"), FString("input tag for number 2"));
-	GameplayTags.InputTag_3 = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("InputTag_3"), FString("input tag for number 3"));
-	GameplayTags.InputTag_4 = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("InputTag_4"), FString("input tag for number 4"));
-
-	GameplayTags.Damage = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Damage"), FString("Damage"));
-	GameplayTags.Damage_Fire = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Damage.Fire"), FString("Fire Damage Type"));
-	GameplayTags.Damage_Lightning = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Damage.Lightning"), FString("Lightning Damage Type"));
-	GameplayTags.Damage_Arcane = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Damage.Arcane"), FString("Arcane Damage Type"));
-	GameplayTags.Damage_Physical = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Damage.Physical"), FString("Physical Damage Type"));
-
-	GameplayTags.Attribute_Resistance_Fire = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Resistance.Fire"), FString("Fire Resistance Type"));
-	GameplayTags.Attribute_Resistance_Lightning = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Resistance.Lightning"), FString("Lightning Resistance Type"));
-	GameplayTags.Attribute_Resistance_Arcane = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Resistance.Arcane"), FString("Arcane Resistance Type"));
-	GameplayTags.Attribute_Resistance_Physical = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Attributes.Resistance.Physical"), FString("Physical Resistance Type"));
-
-	GameplayTags.DamageTypesToResistances.Add(GameplayTags.Damage_Arcane, GameplayTags.Attribute_Resistance_Arcane);
-	GameplayTags.DamageTypesToResistances.Add(GameplayTags.Damage_Fire, GameplayTags.Attribute_Resistance_Fire);
-	GameplayTags.DamageTypesToResistances.Add(GameplayTags.Damage_Lightning, GameplayTags.Attribute_Resistance_Lightning);
-	GameplayTags.DamageTypesToResistances.Add(GameplayTags.Damage_Physical, GameplayTags.Attribute_Resistance_Physical);
-	
-	
-	GameplayTags.Effects_HitReact = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Effects.HitReact"), FString("react to damage"));
-	
-	GameplayTags.Abilities_Attack = UGameplayTagsManager::Get().AddNativeGameplayTag(FName("Abilities.Attack"), FString("Attack ability"));
+	UGameplayTagsManager& Manager = UGameplayTagsManager::Get();
+
+#define AURA_NATIVE_TAG_REGISTER(Member, TagName, DevComment) \
+	GameplayTags.Member = Manager.AddNativeGameplayTag(FName(TagName), FString(DevComment)); \
+	GameplayTags.NativeTagIndex.Add(GameplayTags.Member, EAuraGameplayTag::Member);
+	AURA_NATIVE_GAMEPLAY_TAGS(AURA_NATIVE_TAG_REGISTER)
+#undef AURA_NATIVE_TAG_REGISTER
+
+	GameplayTags.DamageTypesToResistances.Reset();
+#define AURA_DAMAGE_TYPE_REGISTER(DamageTypeMember, ResistanceMember) \
+	GameplayTags.DamageTypesToResistances.Emplace(GameplayTags.DamageTypeMember, GameplayTags.ResistanceMember);
+	AURA_DAMAGE_TYPES(AURA_DAMAGE_TYPE_REGISTER)
+#undef AURA_DAMAGE_TYPE_REGISTER
 }
+
+EAuraGameplayTag FAuraGameplayTags::FindNativeTag(const FGameplayTag& Tag) const
+{
+	const EAuraGameplayTag* NativeTag = NativeTagIndex.Find(Tag);
+	return NativeTag ? *NativeTag : EAuraGameplayTag::None;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand CmdAuraTagsBenchmark(
+	TEXT("Aura.Tags.Benchmark"),
+	TEXT("Times native tag access by name lookup, by hash and by dense index. Optional argument: iterations."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100000;
+		const FAuraGameplayTags& Tags = FAuraGameplayTags::Get();
+		constexpr int32 NumTags = static_cast<int32>(EAuraGameplayTag::Count);
+
+		TArray<FName, TInlineAllocator<NumTags>> TagNames;
+		for (int32 Index = 0; Index < NumTags; ++Index)
+		{
+			TagNames.Add(Tags.GetTag(static_cast<EAuraGameplayTag>(Index)).GetTagName());
+		}
+
+		int32 Matches = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Matches += FGameplayTag::RequestGameplayTag(TagNames[Iteration % NumTags]).IsValid();
+		}
+		const double RequestTime = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const FGameplayTag& Tag = Tags.GetTag(static_cast<EAuraGameplayTag>(Iteration % NumTags));
+			Matches += Tags.FindNativeTag(Tag) != EAuraGameplayTag::None;
+		}
+		const double HashTime = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Matches += Tags.GetTag(static_cast<EAuraGameplayTag>(Iteration % NumTags)).IsValid();
+		}
+		const double IndexTime = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			for (const TPair<FGameplayTag, FGameplayTag>& Pair : Tags.DamageTypesToResistances)
+			{
+				Matches += Pair.Value.IsValid();
+			}
+		}
+		const double DamageTypesTime = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogTemp, Display, TEXT("Aura.Tags.Benchmark %d iterations (%d): RequestGameplayTag %.3f ms, FindNativeTag %.3f ms, GetTag %.3f ms, DamageTypes iteration %.3f ms"),
+			Iterations, Matches, RequestTime * 1000.0, HashTime * 1000.0, IndexTime * 1000.0, DamageTypesTime * 1000.0);
+	}));
+#endif
@@ -5,6 +5,7 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "PlayerController/AuraPlayerState.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
+#include "AbilitySystem/AuraAttributeSet.h"
 #include "PlayerController/AuraPlayerController.h"
 #include "UI/HUD/AuraHUD.h"
 
@@ -34,6 +35,9 @@ void AAuraCharacter::PossessedBy(AController* NewController)
 	Super::PossessedBy(NewController);
 	InitAbilityActorInfo();
 	AddCharacterAbilities();
+
+	// Players have no health bar over their heads, other clients don't need their health
+	CastChecked<UAuraAttributeSet>(AttributeSet)->SetVitalsReplicatedToAll(false);
 }
 
 void AAuraCharacter::OnRep_PlayerState()
@@ -10,6 +10,9 @@
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Game/AuraSignificanceSubsystem.h"
+#include "BrainComponent.h"
+#include "UI/HUD/AuraHealthBarSubsystem.h"
 
 
 AAuraEnemy::AAuraEnemy()
@@ -45,6 +48,19 @@ void AAuraEnemy::Die()
 	Super::Die();
 }
 
+void AAuraEnemy::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Before BeginPlay, so the component never creates its widget.
+	if (bUseSharedHealthBar && HealthBar)
+	{
+		SharedHealthBarOffset = HealthBar->GetComponentLocation() - GetActorLocation();
+		HealthBar->DestroyComponent();
+		HealthBar = nullptr;
+	}
+}
+
 void AAuraEnemy::BeginPlay()
 {
 	Super::BeginPlay();
@@ -54,8 +70,19 @@ void AAuraEnemy::BeginPlay()
 	{
 		UAuraAbilitySystemLibrary::GiveStartupAbilities(this, AbilitySystemComponent, CharacterClass);
 	}
-	UAuraUserWidget* AuraUserWidget = Cast<UAuraUserWidget>( HealthBar->GetUserWidgetObject());
-	if (AuraUserWidget)
+	if (bUseSharedHealthBar)
+	{
+		if (UAuraHealthBarSubsystem* HealthBarSubsystem = GetWorld()->GetSubsystem<UAuraHealthBarSubsystem>())
+		{
+			SharedHealthBarHandle = HealthBarSubsystem->RegisterHealthBar(this, SharedHealthBarOffset);
+		}
+		if (SharedHealthBarHandle != INDEX_NONE)
+		{
+			OnHealthChanged.AddDynamic(this, &AAuraEnemy::SetSharedHealthBarHealth);
+			OnMaxHealthChanged.AddDynamic(this, &AAuraEnemy::SetSharedHealthBarMaxHealth);
+		}
+	}
+	else if (UAuraUserWidget* AuraUserWidget = Cast<UAuraUserWidget>(HealthBar->GetUserWidgetObject()))
 	{
 		AuraUserWidget->SetWidgetController(this);
 	}
@@ -81,6 +108,79 @@ void AAuraEnemy::BeginPlay()
 		OnHealthChanged.Broadcast(AuraASC->GetHealth());
 		OnMaxHealthChanged.Broadcast(AuraASC->GetMaxHealth());
 	}
+
+	DefaultNetUpdateFrequency = NetUpdateFrequency;
+	if (UAuraSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UAuraSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->RegisterEnemy(this);
+	}
+}
+
+void AAuraEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAuraHealthBarSubsystem* HealthBarSubsystem = GetWorld()->GetSubsystem<UAuraHealthBarSubsystem>())
+	{
+		HealthBarSubsystem->UnregisterHealthBar(SharedHealthBarHandle);
+		SharedHealthBarHandle = INDEX_NONE;
+	}
+	if (UAuraSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UAuraSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterEnemy(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void AAuraEnemy::ApplySignificance(EAuraSignificanceBucket Bucket, bool bVisible)
+{
+	const FAuraSignificanceSettings& Settings = UAuraSignificanceSubsystem::GetSettings(Bucket);
+	bSignificanceApplied = true;
+
+	GetCharacterMovement()->SetComponentTickInterval(Settings.MovementTickInterval);
+
+	if (HasAuthority())
+	{
+		NetUpdateFrequency = FMath::Max(DefaultNetUpdateFrequency * Settings.NetUpdateFrequencyScale, MinNetUpdateFrequency);
+		UBrainComponent* BrainComponent = AuraAIController ? AuraAIController->GetBrainComponent() : nullptr;
+		if (BrainComponent && BrainComponent->IsPaused() != Settings.bPauseBehaviorTree)
+		{
+			if (Settings.bPauseBehaviorTree)
+			{
+				BrainComponent->PauseLogic(TEXT("Dormant"));
+			}
+			else
+			{
+				BrainComponent->ResumeLogic(TEXT("Dormant"));
+			}
+		}
+	}
+
+	// Off-screen bars neither draw nor tick.
+	const bool bShowHealthBar = Settings.bShowHealthBar && bVisible;
+	if (HealthBar)
+	{
+		HealthBar->SetVisibility(bShowHealthBar);
+		HealthBar->SetComponentTickEnabled(bShowHealthBar);
+	}
+	else if (UAuraHealthBarSubsystem* HealthBarSubsystem = GetWorld()->GetSubsystem<UAuraHealthBarSubsystem>())
+	{
+		HealthBarSubsystem->SetHealthBarVisible(SharedHealthBarHandle, bShowHealthBar);
+	}
+}
+
+void AAuraEnemy::SetSharedHealthBarHealth(float NewValue)
+{
+	if (UAuraHealthBarSubsystem* HealthBarSubsystem = GetWorld()->GetSubsystem<UAuraHealthBarSubsystem>())
+	{
+		HealthBarSubsystem->SetHealth(SharedHealthBarHandle, NewValue);
+	}
+}
+
+void AAuraEnemy::SetSharedHealthBarMaxHealth(float NewValue)
+{
+	if (UAuraHealthBarSubsystem* HealthBarSubsystem = GetWorld()->GetSubsystem<UAuraHealthBarSubsystem>())
+	{
+		HealthBarSubsystem->SetMaxHealth(SharedHealthBarHandle, NewValue);
+	}
 }
 
 
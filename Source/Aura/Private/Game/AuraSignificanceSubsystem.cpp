@@ -0,0 +1,148 @@
+
+#include "Game/AuraSignificanceSubsystem.h"
+#include "Character/AuraEnemy.h"
+#include "SignificanceManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Aura/Aura.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_AuraSignificanceUpdate, STATGROUP_Aura);
+
+static TAutoConsoleVariable<float> CVarAuraSignificanceMediumDistance(
+	TEXT("Aura.Significance.MediumDistance"),
+	1500.f,
+	TEXT("Enemies further than this from every player drop to the Medium significance bucket."));
+
+static TAutoConsoleVariable<float> CVarAuraSignificanceLowDistance(
+	TEXT("Aura.Significance.LowDistance"),
+	3000.f,
+	TEXT("Enemies further than this from every player drop to the Low significance bucket."));
+
+static TAutoConsoleVariable<float> CVarAuraSignificanceDormantDistance(
+	TEXT("Aura.Significance.DormantDistance"),
+	6000.f,
+	TEXT("Enemies further than this from every player drop to the Dormant significance bucket."));
+
+namespace AuraSignificance
+{
+	static const FName EnemyTag("AuraEnemy");
+
+	static const FAuraSignificanceSettings Settings[] =
+	{
+		// Movement tick, pause BT, net frequency scale, health bar
+		{ 0.f, false, 1.f, true },
+		{ 0.f, false, 0.5f, true },
+		{ 0.05f, false, 0.2f, true },
+		{ 0.1f, true, 0.05f, false },
+	};
+	static_assert(UE_ARRAY_COUNT(Settings) == static_cast<int32>(EAuraSignificanceBucket::Count), "One settings entry per bucket");
+
+	// Significance = bucket score * 2 + visible bit, so the max over all viewpoints keeps the nearest bucket.
+	static float EncodeSignificance(EAuraSignificanceBucket Bucket, bool bVisible)
+	{
+		const int32 BucketScore = static_cast<int32>(EAuraSignificanceBucket::Count) - 1 - static_cast<int32>(Bucket);
+		return static_cast<float>(BucketScore * 2 + (bVisible ? 1 : 0));
+	}
+
+	static void DecodeSignificance(float Significance, EAuraSignificanceBucket& OutBucket, bool& bOutVisible)
+	{
+		const int32 Encoded = FMath::RoundToInt(Significance);
+		OutBucket = static_cast<EAuraSignificanceBucket>(static_cast<int32>(EAuraSignificanceBucket::Count) - 1 - Encoded / 2);
+		bOutVisible = (Encoded & 1) != 0;
+	}
+}
+
+EAuraSignificanceBucket UAuraSignificanceSubsystem::GetBucketForDistanceSquared(float DistanceSquared) const
+{
+	if (DistanceSquared > DormantDistanceSquared) return EAuraSignificanceBucket::Dormant;
+	if (DistanceSquared > LowDistanceSquared) return EAuraSignificanceBucket::Low;
+	if (DistanceSquared > MediumDistanceSquared) return EAuraSignificanceBucket::Medium;
+	return EAuraSignificanceBucket::High;
+}
+
+void UAuraSignificanceSubsystem::RegisterEnemy(AAuraEnemy* Enemy)
+{
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (SignificanceManager == nullptr || Enemy == nullptr) return;
+
+	// Dedicated servers never render, there only the distance matters.
+	const bool bCheckRendered = GetWorld()->GetNetMode() != NM_DedicatedServer;
+
+	SignificanceManager->RegisterObject(Enemy, AuraSignificance::EnemyTag,
+		[this, bCheckRendered](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+		{
+			const AAuraEnemy* ManagedEnemy = CastChecked<AAuraEnemy>(ObjectInfo->GetObject());
+			const float DistanceSquared = FVector::DistSquared(ManagedEnemy->GetActorLocation(), Viewpoint.GetLocation());
+			const bool bVisible = !bCheckRendered || ManagedEnemy->WasRecentlyRendered(0.2f);
+			return AuraSignificance::EncodeSignificance(GetBucketForDistanceSquared(DistanceSquared), bVisible);
+		},
+		USignificanceManager::EPostSignificanceType::Sequential,
+		[](USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+		{
+			// Runs for every object on every Update, only bucket or visibility changes reach the enemy
+			AAuraEnemy* ManagedEnemy = CastChecked<AAuraEnemy>(ObjectInfo->GetObject());
+			if (OldSignificance == Significance && ManagedEnemy->HasAppliedSignificance()) return;
+
+			EAuraSignificanceBucket Bucket;
+			bool bVisible;
+			AuraSignificance::DecodeSignificance(Significance, Bucket, bVisible);
+			ManagedEnemy->ApplySignificance(Bucket, bVisible);
+		});
+}
+
+void UAuraSignificanceSubsystem::UnregisterEnemy(AAuraEnemy* Enemy)
+{
+	if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+	{
+		SignificanceManager->UnregisterObject(Enemy);
+	}
+}
+
+const FAuraSignificanceSettings& UAuraSignificanceSubsystem::GetSettings(EAuraSignificanceBucket Bucket)
+{
+	return AuraSignificance::Settings[static_cast<int32>(Bucket)];
+}
+
+void UAuraSignificanceSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraSignificanceUpdate);
+
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (SignificanceManager == nullptr) return;
+
+	// La funcion de significancia puede correr fuera del game thread, los cvars se leen aqui
+	MediumDistanceSquared = FMath::Square(CVarAuraSignificanceMediumDistance.GetValueOnGameThread());
+	LowDistanceSquared = FMath::Square(CVarAuraSignificanceLowDistance.GetValueOnGameThread());
+	DormantDistanceSquared = FMath::Square(CVarAuraSignificanceDormantDistance.GetValueOnGameThread());
+
+	GatherViewpoints();
+	if (Viewpoints.Num() > 0)
+	{
+		SignificanceManager->Update(Viewpoints);
+	}
+}
+
+void UAuraSignificanceSubsystem::GatherViewpoints()
+{
+	// Server sees every player controller, clients only their local ones.
+	Viewpoints.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC == nullptr || PC->GetPawnOrSpectator() == nullptr) continue;
+
+		FVector Location;
+		FRotator Rotation;
+		PC->GetPlayerViewPoint(Location, Rotation);
+		Viewpoints.Emplace(Rotation, Location);
+	}
+}
+
+TStatId UAuraSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool UAuraSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
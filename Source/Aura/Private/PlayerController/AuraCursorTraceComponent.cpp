@@ -0,0 +1,81 @@
+
+#include "PlayerController/AuraCursorTraceComponent.h"
+#include "Aura/Aura.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Cursor Trace"), STAT_AuraCursorTrace, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cursor Traces"), STAT_AuraCursorTraces, STATGROUP_Aura);
+
+UAuraCursorTraceComponent::UAuraCursorTraceComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	AsyncTraceDelegate.BindUObject(this, &UAuraCursorTraceComponent::OnAsyncTraceDone);
+}
+
+bool UAuraCursorTraceComponent::UpdateCursorHit(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraCursorTrace);
+
+	// Un resultado async que llegó desde la última actualización
+	bool bChanged = bCursorHitChanged;
+	bCursorHitChanged = false;
+
+	APlayerController* PC = GetOwner<APlayerController>();
+	if (PC == nullptr || !PC->IsLocalController()) return bChanged;
+
+	TimeSinceTrace += DeltaTime;
+
+	FVector2D MousePosition;
+	if (!PC->GetMousePosition(MousePosition.X, MousePosition.Y)) return bChanged;
+
+	FVector CameraLocation;
+	FRotator CameraRotation;
+	PC->GetPlayerViewPoint(CameraLocation, CameraRotation);
+
+	if (!ShouldTrace(MousePosition, CameraLocation, CameraRotation)) return bChanged;
+
+	bHasTraced = true;
+	TimeSinceTrace = 0.f;
+	LastMousePosition = MousePosition;
+	LastCameraLocation = CameraLocation;
+	LastCameraRotation = CameraRotation;
+	INC_DWORD_STAT(STAT_AuraCursorTraces);
+
+	if (!bUseAsyncTrace)
+	{
+		PC->GetHitResultAtScreenPosition(MousePosition, TraceChannel, false, CursorHit);
+		return true;
+	}
+
+	// Una sola traza en vuelo, la siguiente sale cuando llegue el resultado
+	if (GetWorld()->IsTraceHandleValid(PendingTraceHandle, false)) return bChanged;
+
+	FVector WorldOrigin;
+	FVector WorldDirection;
+	if (PC->DeprojectScreenPositionToWorld(MousePosition.X, MousePosition.Y, WorldOrigin, WorldDirection))
+	{
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AuraCursorTrace), false);
+		PendingTraceHandle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, WorldOrigin,
+			WorldOrigin + WorldDirection * PC->HitResultTraceDistance, TraceChannel, QueryParams,
+			FCollisionResponseParams::DefaultResponseParam, &AsyncTraceDelegate);
+	}
+	return bChanged;
+}
+
+bool UAuraCursorTraceComponent::ShouldTrace(const FVector2D& MousePosition, const FVector& CameraLocation, const FRotator& CameraRotation) const
+{
+	return !bHasTraced
+		|| TimeSinceTrace >= MaxTraceInterval
+		|| FVector2D::DistSquared(MousePosition, LastMousePosition) > FMath::Square(MouseMoveThreshold)
+		|| FVector::DistSquared(CameraLocation, LastCameraLocation) > FMath::Square(CameraMoveThreshold)
+		|| !CameraRotation.Equals(LastCameraRotation, CameraRotationThreshold);
+}
+
+void UAuraCursorTraceComponent::OnAsyncTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	if (!(TraceHandle == PendingTraceHandle)) return;
+
+	PendingTraceHandle = FTraceHandle();
+	CursorHit = TraceDatum.OutHits.Num() > 0 ? TraceDatum.OutHits[0] : FHitResult();
+	bCursorHitChanged = true;
+}
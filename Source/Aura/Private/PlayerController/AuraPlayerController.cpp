@@ -9,32 +9,112 @@
 #include "AuraGameplayTags.h"
 #include "Components/SplineComponent.h"
 #include "NavigationSystem.h"
-#include "NavigationPath.h"
+#include "NavigationData.h"
 #include "GameFramework/Character.h"
 #include "UI/Widget/DamageTextComponent.h"
+#include "PlayerController/AuraCursorTraceComponent.h"
+#include "UI/Widget/DamageTextPoolComponent.h"
+#include "Aura/Aura.h"
+
+DECLARE_CYCLE_STAT(TEXT("Click To Move Path Request"), STAT_AuraClickToMovePathRequest, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damage Number RPCs"), STAT_AuraDamageNumberRPCs, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damage Numbers Sent"), STAT_AuraDamageNumbersSent, STATGROUP_Aura);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Click To Move Path Latency (ms)"), STAT_AuraClickToMovePathLatency, STATGROUP_Aura);
+
+// Keeps one batch well under the unreliable RPC size limit, the rest go in the next RPC.
+static constexpr int32 MaxDamageNumbersPerRPC = 64;
+
+#if ENABLE_DRAW_DEBUG
+static TAutoConsoleVariable<bool> CVarAuraDrawClickToMovePath(
+	TEXT("Aura.Debug.DrawClickToMovePath"),
+	false,
+	TEXT("Draws the points of every click to move path."));
+#endif
 
 AAuraPlayerController::AAuraPlayerController()
 {
 	bReplicates = true;
 	Spline = CreateDefaultSubobject<USplineComponent>("Spline");
+	CursorTraceComponent = CreateDefaultSubobject<UAuraCursorTraceComponent>("CursorTraceComponent");
+	DamageTextPool = CreateDefaultSubobject<UDamageTextPoolComponent>("DamageTextPool");
 }
 
 void AAuraPlayerController::PlayerTick(float DeltaTime)
 {
 	Super::PlayerTick(DeltaTime);
-	CursorTrace();
+	CursorTrace(DeltaTime);
 	AutoRun();
 }
 
-void AAuraPlayerController::ShowDamageNumber_Implementation(float DamageAmount, ACharacter* TargetCharacter, bool bIsBlockedHit, bool bIsCriticalHit)
+bool FAuraDamageNumber::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// False for a target not mapped yet on this client, that entry just arrives with a null target
+	UObject* Target = TargetCharacter;
+	Map->SerializeObject(Ar, ACharacter::StaticClass(), Target);
+
+	uint16 QuantizedAmount = 0;
+	uint8 Flags = 0;
+	if (Ar.IsSaving())
+	{
+		QuantizedAmount = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(DamageAmount), 0, static_cast<int32>(MAX_uint16)));
+		Flags = (bIsBlockedHit ? 1 : 0) | (bIsCriticalHit ? 2 : 0);
+	}
+	Ar << QuantizedAmount;
+	Ar.SerializeBits(&Flags, 2);
+
+	if (Ar.IsLoading())
+	{
+		TargetCharacter = Cast<ACharacter>(Target);
+		DamageAmount = QuantizedAmount;
+		bIsBlockedHit = (Flags & 1) != 0;
+		bIsCriticalHit = (Flags & 2) != 0;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+void AAuraPlayerController::ShowDamageNumber(float DamageAmount, ACharacter* TargetCharacter, bool bIsBlockedHit, bool bIsCriticalHit)
+{
+	if (!IsValid(TargetCharacter)) return;
+
+	FAuraDamageNumber& DamageNumber = PendingDamageNumbers.AddDefaulted_GetRef();
+	DamageNumber.TargetCharacter = TargetCharacter;
+	DamageNumber.DamageAmount = DamageAmount;
+	DamageNumber.bIsBlockedHit = bIsBlockedHit;
+	DamageNumber.bIsCriticalHit = bIsCriticalHit;
+
+	if (!GetWorldTimerManager().TimerExists(FlushDamageNumbersTimer))
+	{
+		FlushDamageNumbersTimer = GetWorldTimerManager().SetTimerForNextTick(this, &AAuraPlayerController::FlushDamageNumbers);
+	}
+}
+
+void AAuraPlayerController::FlushDamageNumbers()
 {
-	if (IsValid(TargetCharacter) && DamageComponentTextClass && IsLocalController())
+	FlushDamageNumbersTimer.Invalidate();
+
+	for (int32 First = 0; First < PendingDamageNumbers.Num(); First += MaxDamageNumbersPerRPC)
+	{
+		const int32 Count = FMath::Min(MaxDamageNumbersPerRPC, PendingDamageNumbers.Num() - First);
+		ClientShowDamageNumbers(TArray<FAuraDamageNumber>(PendingDamageNumbers.GetData() + First, Count));
+		INC_DWORD_STAT(STAT_AuraDamageNumberRPCs);
+		INC_DWORD_STAT_BY(STAT_AuraDamageNumbersSent, Count);
+	}
+	PendingDamageNumbers.Reset();
+}
+
+void AAuraPlayerController::ClientShowDamageNumbers_Implementation(const TArray<FAuraDamageNumber>& DamageNumbers)
+{
+	if (!DamageComponentTextClass || !IsLocalController()) return;
+
+	for (const FAuraDamageNumber& DamageNumber : DamageNumbers)
 	{
-		UDamageTextComponent* DamageText = NewObject<UDamageTextComponent>(TargetCharacter, DamageComponentTextClass);
-		DamageText->RegisterComponent();
-		DamageText->AttachToComponent(TargetCharacter->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
-		DamageText->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
-		DamageText->SetDamageText(DamageAmount, bIsBlockedHit, bIsCriticalHit);
+		// Targets not relevant to this client arrive as null.
+		if (IsValid(DamageNumber.TargetCharacter))
+		{
+			DamageTextPool->ShowDamageText(DamageComponentTextClass, DamageNumber.TargetCharacter, DamageNumber.DamageAmount, DamageNumber.bIsBlockedHit, DamageNumber.bIsCriticalHit);
+		}
 	}
 }
 
@@ -43,24 +123,44 @@ void AAuraPlayerController::AutoRun()
 	if (!bAutoRunning) return;
 
 	// Obtenemos el Pawn controlado por este PlayerController
-	if (APawn* ControlledPawn = GetPawn())
+	APawn* ControlledPawn = GetPawn();
+	if (ControlledPawn && AutoRunPathPoints.Num() > 1)
 	{
-		// Encontramos la ubicaci�n en el Spline que est� m�s cerca de la posici�n actual del personaje
-		// Esto nos ayuda a mantener al personaje alineado con el Spline mientras se mueve
-		const FVector LocationOnSpline = Spline->FindLocationClosestToWorldLocation(
-			ControlledPawn->GetActorLocation(), ESplineCoordinateSpace::World);
-
-		// Calculamos la direcci�n del movimiento basada en el punto m�s cercano en el Spline
-		// Esto nos da un vector que apunta hacia adelante a lo largo del Spline
-		const FVector Direction = Spline->FindDirectionClosestToWorldLocation(
-			LocationOnSpline, ESplineCoordinateSpace::World);
-
-		// Aplicamos la direcci�n calculada como input de movimiento para el personaje
-		// Esto har� que el personaje se mueva en la direcci�n especificada
+		const FVector PawnLocation = ControlledPawn->GetActorLocation();
+		const int32 LastSegmentIndex = AutoRunPathPoints.Num() - 2;
+
+		// Avanzamos de segmento cuando el personaje pasa el final del actual o llega a su punto final.
+		// El indice solo crece, asi que el coste por tick no depende del largo de la ruta
+		float SegmentAlpha = 0.f;
+		while (true)
+		{
+			const FVector SegmentStart = AutoRunPathPoints[AutoRunSegmentIndex];
+			const FVector SegmentEnd = AutoRunPathPoints[AutoRunSegmentIndex + 1];
+			const FVector Segment = (SegmentEnd - SegmentStart) * FVector(1.f, 1.f, 0.f);
+			const float SegmentLengthSquared = Segment.SizeSquared();
+			SegmentAlpha = SegmentLengthSquared > UE_KINDA_SMALL_NUMBER ? FVector::DotProduct(PawnLocation - SegmentStart, Segment) / SegmentLengthSquared : 1.f;
+
+			const bool bReachedSegmentEnd = SegmentAlpha >= 1.f || FVector::DistSquared2D(PawnLocation, SegmentEnd) <= FMath::Square(AutoRunAcceptanceRadius);
+			if (!bReachedSegmentEnd || AutoRunSegmentIndex == LastSegmentIndex) break;
+			++AutoRunSegmentIndex;
+		}
+
+		const FVector SegmentStart = AutoRunPathPoints[AutoRunSegmentIndex];
+		const FVector SegmentEnd = AutoRunPathPoints[AutoRunSegmentIndex + 1];
+
+		// Si el personaje se desvio demasiado del segmento pedimos una ruta nueva, sin dejar de movernos
+		const FVector ClosestPointOnSegment = FMath::Lerp(SegmentStart, SegmentEnd, FMath::Clamp(SegmentAlpha, 0.f, 1.f));
+		if (FVector::DistSquared2D(PawnLocation, ClosestPointOnSegment) > FMath::Square(AutoRunRepathDistance) && ClickToMovePathId == INVALID_NAVQUERYID)
+		{
+			RequestClickToMovePath(ControlledPawn);
+		}
+
+		// Nos movemos hacia el final del segmento actual
+		const FVector Direction = ((SegmentEnd - PawnLocation) * FVector(1.f, 1.f, 0.f)).GetSafeNormal();
 		ControlledPawn->AddMovementInput(Direction);
 
-		// Calculamos la distancia entre la ubicaci�n actual en el Spline y el destino final
-		const float DistanceToDestination = (LocationOnSpline - CachedDestination).Length();
+		// Calculamos la distancia entre la ubicacion actual del personaje y el destino final
+		const float DistanceToDestination = FVector::Dist2D(PawnLocation, CachedDestination);
 
 		// Si la distancia al destino es menor o igual al radio de aceptaci�n (AutoRunAcceptanceRadius),
 		// consideramos que hemos llegado al destino y desactivamos el auto-run
@@ -72,10 +172,12 @@ void AAuraPlayerController::AutoRun()
 }
 
 
-void AAuraPlayerController::CursorTrace()
+void AAuraPlayerController::CursorTrace(float DeltaTime)
 {
-	
-	GetHitResultUnderCursor(ECollisionChannel::ECC_Visibility, false, CursorHit);
+	// Solo re-evaluamos el highlight cuando el componente trae una traza nueva
+	if (!CursorTraceComponent->UpdateCursorHit(DeltaTime)) return;
+
+	const FHitResult& CursorHit = CursorTraceComponent->GetCursorHit();
 	if (!CursorHit.bBlockingHit) return;
 
 	LastActor = ThisActor;
@@ -186,31 +288,9 @@ void AAuraPlayerController::AbilityInputTagReleased(FGameplayTag InputTag)
 			// Comprobamos si el tiempo que se ha mantenido presionado (FollowTime) es menor que el umbral de tiempo corto (ShortPressThreshold)
 			if (FollowTime <= ShortPressThreshold && ControlledPawn)
 			{
-				// Intentamos encontrar una ruta de navegaci�n desde la ubicaci�n actual del personaje hasta el destino almacenado (CachedDestination)
-				if (UNavigationPath* NavPath = UNavigationSystemV1::FindPathToLocationSynchronously(
-					this, ControlledPawn->GetActorLocation(), CachedDestination))
-				{
-					// Limpiamos los puntos anteriores en el Spline, si es que existen
-					Spline->ClearSplinePoints();
-
-					// Iteramos a trav�s de todos los puntos en la ruta calculada
-					for (const FVector& PointLocation : NavPath->PathPoints)
-					{
-						// A�adimos cada punto al Spline para crear una trayectoria visual
-						Spline->AddSplinePoint(PointLocation, ESplineCoordinateSpace::World);
-
-						// Dibujamos una esfera verde en cada punto para prop�sitos de depuraci�n 
-						DrawDebugSphere(GetWorld(), PointLocation, 8.f, 8.f, FColor::Green, false, 3.f);
-					}
-
-					if (NavPath->PathPoints.Num() > 0)
-					{
-						CachedDestination = NavPath->PathPoints[NavPath->PathPoints.Num() -1 ];
-
-						// Indicamos que estamos en modo de auto-corre (auto-running) activando la bandera
-						bAutoRunning = true;
-					}
-				}
+				// Empezamos a movernos en linea recta y pedimos la ruta de navegacion de forma asincrona
+				SetAutoRunPath({ ControlledPawn->GetActorLocation(), CachedDestination });
+				RequestClickToMovePath(ControlledPawn);
 			}
 
 			// Reiniciamos el tiempo de seguimiento (FollowTime) a 0 ya que hemos completado la acci�n
@@ -251,6 +331,7 @@ void AAuraPlayerController::AbilityInputTagHeld(FGameplayTag InputTag)
 
 		// Obtener la posici�n en el mundo debajo del cursor del rat�n
 
+		const FHitResult& CursorHit = CursorTraceComponent->GetCursorHit();
 		if (CursorHit.bBlockingHit)
 		{
 			CachedDestination = CursorHit.ImpactPoint; // Guardamos la posici�n del impacto en CachedDestination
@@ -267,6 +348,81 @@ void AAuraPlayerController::AbilityInputTagHeld(FGameplayTag InputTag)
 	}
 }
 
+void AAuraPlayerController::RequestClickToMovePath(const APawn* ControlledPawn)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AuraClickToMovePathRequest);
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (NavSys == nullptr) return;
+
+	if (ClickToMovePathId != INVALID_NAVQUERYID)
+	{
+		NavSys->AbortAsyncFindPathRequest(ClickToMovePathId);
+		ClickToMovePathId = INVALID_NAVQUERYID;
+	}
+
+	const FNavAgentProperties& AgentProperties = ControlledPawn->GetNavAgentPropertiesRef();
+	const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProperties, ControlledPawn->GetNavAgentLocation());
+	if (NavData == nullptr) return;
+
+	FPathFindingQuery Query(this, *NavData, ControlledPawn->GetNavAgentLocation(), CachedDestination);
+	ClickToMovePathRequestTime = FPlatformTime::Seconds();
+	ClickToMovePathId = NavSys->FindPathAsync(AgentProperties, Query,
+		FNavPathQueryDelegate::CreateUObject(this, &AAuraPlayerController::OnClickToMovePathFound));
+}
+
+void AAuraPlayerController::OnClickToMovePathFound(uint32 PathId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	// Respuesta de una peticion ya reemplazada o cancelada
+	if (PathId != ClickToMovePathId) return;
+	ClickToMovePathId = INVALID_NAVQUERYID;
+
+	SET_FLOAT_STAT(STAT_AuraClickToMovePathLatency, (FPlatformTime::Seconds() - ClickToMovePathRequestTime) * 1000.0);
+
+	// Si el jugador ya cancelo el auto-run no pisamos su input
+	if (!bAutoRunning) return;
+
+	if (Result != ENavigationQueryResult::Success || !Path.IsValid() || Path->GetPathPoints().Num() == 0)
+	{
+		bAutoRunning = false;
+		return;
+	}
+
+	TArray<FVector> PathPoints;
+	PathPoints.Reserve(Path->GetPathPoints().Num());
+	for (const FNavPathPoint& PathPoint : Path->GetPathPoints())
+	{
+		PathPoints.Add(PathPoint.Location);
+	}
+	SetAutoRunPath(PathPoints);
+}
+
+void AAuraPlayerController::SetAutoRunPath(const TArray<FVector>& PathPoints)
+{
+	if (PathPoints.Num() < 2) return;
+
+	AutoRunPathPoints = PathPoints;
+	AutoRunSegmentIndex = 0;
+
+	// El spline queda como representacion visible de la ruta, el seguimiento usa AutoRunPathPoints
+	Spline->ClearSplinePoints(false);
+	for (const FVector& PointLocation : PathPoints)
+	{
+		Spline->AddSplinePoint(PointLocation, ESplineCoordinateSpace::World, false);
+
+#if ENABLE_DRAW_DEBUG
+		if (CVarAuraDrawClickToMovePath.GetValueOnGameThread())
+		{
+			DrawDebugSphere(GetWorld(), PointLocation, 8.f, 8, FColor::Green, false, 3.f);
+		}
+#endif
+	}
+	Spline->UpdateSpline();
+
+	CachedDestination = PathPoints.Last();
+	bAutoRunning = true;
+}
+
 UAuraAbilitySystemComponent* AAuraPlayerController::GetASC()
 {
 	if (AuraAbilitySystemComponent == nullptr)
@@ -3,8 +3,27 @@
 #include "UI/Widget/AuraUserWidget.h"
 #include "UI/WidgetController/OverlayWidgetController.h"
 #include "UI/WidgetController/AttributeMenuWidgetController.h"
+#include "UI/Widget/AuraHealthBarLayer.h"
 
 
+AAuraHUD::AAuraHUD()
+{
+	HealthBarLayerClass = UAuraHealthBarLayer::StaticClass();
+}
+
+void AAuraHUD::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (HealthBarLayerClass && GetOwningPlayerController())
+	{
+		HealthBarLayer = CreateWidget<UAuraHealthBarLayer>(GetOwningPlayerController(), HealthBarLayerClass);
+		if (HealthBarLayer)
+		{
+			HealthBarLayer->AddToViewport(-1);
+		}
+	}
+}
 
 UOverlayWidgetController* AAuraHUD::GetOverlayWidgetController(const FWidgetControllerParams& WCParams)
 {
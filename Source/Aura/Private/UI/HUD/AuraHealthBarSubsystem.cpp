@@ -0,0 +1,50 @@
+
+#include "UI/HUD/AuraHealthBarSubsystem.h"
+#include "GameFramework/Actor.h"
+
+int32 UAuraHealthBarSubsystem::RegisterHealthBar(const AActor* Owner, const FVector& Offset)
+{
+	if (Owner == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer) return INDEX_NONE;
+
+	FAuraHealthBarEntry Entry;
+	Entry.Owner = Owner;
+	Entry.Offset = Offset;
+	return Entries.Add(Entry);
+}
+
+void UAuraHealthBarSubsystem::UnregisterHealthBar(int32 Handle)
+{
+	if (Entries.IsValidIndex(Handle))
+	{
+		Entries.RemoveAt(Handle);
+	}
+}
+
+void UAuraHealthBarSubsystem::SetHealth(int32 Handle, float Health)
+{
+	if (Entries.IsValidIndex(Handle))
+	{
+		Entries[Handle].Health = Health;
+	}
+}
+
+void UAuraHealthBarSubsystem::SetMaxHealth(int32 Handle, float MaxHealth)
+{
+	if (Entries.IsValidIndex(Handle))
+	{
+		Entries[Handle].MaxHealth = MaxHealth;
+	}
+}
+
+void UAuraHealthBarSubsystem::SetHealthBarVisible(int32 Handle, bool bVisible)
+{
+	if (Entries.IsValidIndex(Handle))
+	{
+		Entries[Handle].bVisible = bVisible;
+	}
+}
+
+bool UAuraHealthBarSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
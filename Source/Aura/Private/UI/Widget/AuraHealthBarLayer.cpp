@@ -0,0 +1,69 @@
+
+#include "UI/Widget/AuraHealthBarLayer.h"
+#include "UI/HUD/AuraHealthBarSubsystem.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "Rendering/DrawElements.h"
+#include "SceneView.h"
+#include "Aura/Aura.h"
+
+DECLARE_CYCLE_STAT(TEXT("Health Bar Layer Tick"), STAT_AuraHealthBarLayerTick, STATGROUP_Aura);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Health Bars Drawn"), STAT_AuraHealthBarsDrawn, STATGROUP_Aura);
+
+void UAuraHealthBarLayer::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+	SCOPE_CYCLE_COUNTER(STAT_AuraHealthBarLayerTick);
+
+	DrawItems.Reset();
+
+	const UAuraHealthBarSubsystem* HealthBarSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UAuraHealthBarSubsystem>() : nullptr;
+	const APlayerController* PC = GetOwningPlayer();
+	const ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+	if (HealthBarSubsystem == nullptr || LocalPlayer == nullptr || LocalPlayer->ViewportClient == nullptr) return;
+
+	// Una sola matriz de proyeccion por frame para todas las barras
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData)) return;
+	const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+	const float ViewportScale = UWidgetLayoutLibrary::GetViewportScale(this);
+	if (ViewportScale <= 0.f) return;
+
+	DrawItems.Reserve(HealthBarSubsystem->GetEntries().Num());
+	for (const FAuraHealthBarEntry& Entry : HealthBarSubsystem->GetEntries())
+	{
+		const AActor* Owner = Entry.Owner.Get();
+		if (!Entry.bVisible || Owner == nullptr) continue;
+
+		FVector2D ScreenPosition;
+		if (FSceneView::ProjectWorldToScreen(Owner->GetActorLocation() + Entry.Offset, ViewRect, ViewProjectionMatrix, ScreenPosition))
+		{
+			DrawItems.Add({ ScreenPosition / ViewportScale - BarSize * 0.5f, Entry.GetHealthRatio() });
+		}
+	}
+	SET_DWORD_STAT(STAT_AuraHealthBarsDrawn, DrawItems.Num());
+}
+
+int32 UAuraHealthBarLayer::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	LayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	// Backgrounds and fills go to two layers so Slate can batch each of them in one draw call.
+	const int32 BackgroundLayer = LayerId + 1;
+	const int32 FillLayer = LayerId + 2;
+	const FVector2f Size(BarSize);
+	for (const FDrawItem& Item : DrawItems)
+	{
+		const FSlateLayoutTransform Transform(FVector2f(Item.Position));
+		FSlateDrawElement::MakeBox(OutDrawElements, BackgroundLayer, AllottedGeometry.ToPaintGeometry(Size, Transform), &BackgroundBrush, ESlateDrawEffect::None, BackgroundColor);
+		if (Item.HealthRatio > 0.f)
+		{
+			FSlateDrawElement::MakeBox(OutDrawElements, FillLayer, AllottedGeometry.ToPaintGeometry(FVector2f(Size.X * Item.HealthRatio, Size.Y), Transform), &FillBrush, ESlateDrawEffect::None, FillColor);
+		}
+	}
+	return FillLayer;
+}
@@ -0,0 +1,181 @@
+
+#include "UI/Widget/DamageTextPoolComponent.h"
+#include "UI/Widget/DamageTextComponent.h"
+#include "GameFramework/Character.h"
+#include "Aura/Aura.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Texts Visible"), STAT_AuraDamageTextsVisible, STATGROUP_Aura);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damage Texts Created"), STAT_AuraDamageTextsCreated, STATGROUP_Aura);
+
+UDamageTextPoolComponent::UDamageTextPoolComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UDamageTextPoolComponent::ShowDamageText(TSubclassOf<UDamageTextComponent> DamageTextClass, ACharacter* TargetCharacter, float DamageAmount, bool bIsBlockedHit, bool bIsCriticalHit)
+{
+	if (!IsValid(TargetCharacter) || DamageTextClass == nullptr) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Sumamos al numero que el objetivo ya tiene en pantalla
+	if (AggregationWindow > 0.f)
+	{
+		for (int32 Index = ActiveDamageTexts.Num() - 1; Index >= 0; --Index)
+		{
+			FActiveDamageText& Active = ActiveDamageTexts[Index];
+			if (Now - Active.ShowTime > AggregationWindow) break;
+			if (Active.Target.Get() != TargetCharacter || !IsValid(Active.Component)) continue;
+
+			Active.DamageAmount += DamageAmount;
+			Active.bIsBlockedHit |= bIsBlockedHit;
+			Active.bIsCriticalHit |= bIsCriticalHit;
+			Active.ShowTime = Now;
+			Active.Component->SetDamageText(Active.DamageAmount, Active.bIsBlockedHit, Active.bIsCriticalHit);
+
+			// Keep the array ordered by ShowTime.
+			FActiveDamageText Refreshed = MoveTemp(Active);
+			ActiveDamageTexts.RemoveAt(Index);
+			ActiveDamageTexts.Add(MoveTemp(Refreshed));
+			return;
+		}
+	}
+
+	if (ActiveDamageTexts.Num() >= MaxVisibleDamageTexts)
+	{
+		ReleaseDamageText(ActiveDamageTexts[0].Component);
+		ActiveDamageTexts.RemoveAt(0);
+	}
+
+	UDamageTextComponent* DamageText = AcquireDamageText(DamageTextClass);
+
+	// Same placement the per-hit component got: its default relative transform on the target's root
+	const FTransform& RelativeTransform = DamageTextClass->GetDefaultObject<UDamageTextComponent>()->GetRelativeTransform();
+	DamageText->SetWorldTransform(RelativeTransform * TargetCharacter->GetRootComponent()->GetComponentTransform());
+	DamageText->SetVisibility(true);
+	DamageText->SetComponentTickEnabled(true);
+	DamageText->SetDamageText(DamageAmount, bIsBlockedHit, bIsCriticalHit);
+
+	FActiveDamageText& Active = ActiveDamageTexts.AddDefaulted_GetRef();
+	Active.Component = DamageText;
+	Active.Target = TargetCharacter;
+	Active.ShowTime = Now;
+	Active.DamageAmount = DamageAmount;
+	Active.bIsBlockedHit = bIsBlockedHit;
+	Active.bIsCriticalHit = bIsCriticalHit;
+
+	SET_DWORD_STAT(STAT_AuraDamageTextsVisible, ActiveDamageTexts.Num());
+	SetComponentTickEnabled(true);
+}
+
+void UDamageTextPoolComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	int32 NumExpired = 0;
+	while (NumExpired < ActiveDamageTexts.Num() && Now - ActiveDamageTexts[NumExpired].ShowTime >= DamageTextLifetime)
+	{
+		ReleaseDamageText(ActiveDamageTexts[NumExpired].Component);
+		++NumExpired;
+	}
+	ActiveDamageTexts.RemoveAt(0, NumExpired);
+
+	SET_DWORD_STAT(STAT_AuraDamageTextsVisible, ActiveDamageTexts.Num());
+	if (ActiveDamageTexts.Num() == 0)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UDamageTextPoolComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (const FActiveDamageText& Active : ActiveDamageTexts)
+	{
+		if (IsValid(Active.Component))
+		{
+			Active.Component->DestroyComponent();
+		}
+	}
+	ActiveDamageTexts.Reset();
+
+	for (UDamageTextComponent* DamageText : InactiveDamageTexts)
+	{
+		if (IsValid(DamageText))
+		{
+			DamageText->DestroyComponent();
+		}
+	}
+	InactiveDamageTexts.Reset();
+
+	if (IsValid(HostActor))
+	{
+		HostActor->Destroy();
+	}
+	HostActor = nullptr;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UDamageTextComponent* UDamageTextPoolComponent::AcquireDamageText(TSubclassOf<UDamageTextComponent> DamageTextClass)
+{
+	if (PooledClass != DamageTextClass)
+	{
+		for (UDamageTextComponent* DamageText : InactiveDamageTexts)
+		{
+			if (IsValid(DamageText))
+			{
+				DamageText->DestroyComponent();
+			}
+		}
+		InactiveDamageTexts.Reset();
+		PooledClass = DamageTextClass;
+	}
+
+	// Blueprints that still destroy their own component just drop out of the pool.
+	while (InactiveDamageTexts.Num() > 0)
+	{
+		UDamageTextComponent* DamageText = InactiveDamageTexts.Pop(EAllowShrinking::No);
+		if (IsValid(DamageText))
+		{
+			return DamageText;
+		}
+	}
+
+	UDamageTextComponent* DamageText = NewObject<UDamageTextComponent>(GetHostActor(), DamageTextClass);
+	DamageText->RegisterComponent();
+	INC_DWORD_STAT(STAT_AuraDamageTextsCreated);
+	return DamageText;
+}
+
+AActor* UDamageTextPoolComponent::GetHostActor()
+{
+	if (IsValid(HostActor)) return HostActor;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = GetOwner();
+	SpawnParams.ObjectFlags |= RF_Transient;
+	HostActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+	USceneComponent* Root = NewObject<USceneComponent>(HostActor, TEXT("Root"));
+	HostActor->SetRootComponent(Root);
+	Root->RegisterComponent();
+	return HostActor;
+}
+
+void UDamageTextPoolComponent::ReleaseDamageText(UDamageTextComponent* DamageText)
+{
+	if (!IsValid(DamageText)) return;
+
+	DamageText->SetVisibility(false);
+	DamageText->SetComponentTickEnabled(false);
+	if (DamageText->GetClass() == PooledClass)
+	{
+		InactiveDamageTexts.Add(DamageText);
+	}
+	else
+	{
+		DamageText->DestroyComponent();
+	}
+}
@@ -4,38 +4,58 @@
 #include "AbilitySystem/Data/AttributeInfoDataAsset.h"
 #include "AuraGameplayTags.h"
 
-void UAttributeMenuWidgetController::BroadcastAttributeInfo(const FGameplayTag& AttributeTag, const FGameplayAttribute& Attribute) const
+void UAttributeMenuWidgetController::BroadcastAttributeInfo(EAuraAttribute AuraAttribute) const
 {
-	FAuraAttributeInfo Info = AttributeInfo->FindAttributeInfoForTag(AttributeTag);
-	Info.AttributeValue = Attribute.GetNumericValue(AttributeSet);
+	const FAuraAttributeDescriptor& Descriptor = UAuraAttributeSet::GetAttributeDescriptor(AuraAttribute);
+	if (!Descriptor.HasTag()) return;
+
+	if (CachedAttributeInfo.Num() == 0)
+	{
+		for (const FAuraAttributeDescriptor& Entry : UAuraAttributeSet::GetAttributeDescriptors())
+		{
+			CachedAttributeInfo.Add(Entry.HasTag() ? AttributeInfo->FindAttributeInfoForTag(Entry.GetTag()) : FAuraAttributeInfo());
+		}
+	}
+
+	FAuraAttributeInfo& Info = CachedAttributeInfo[static_cast<int32>(AuraAttribute)];
+	Info.AttributeValue = Descriptor.Attribute.GetNumericValue(AttributeSet);
 	FAttributeInfoDelegate.Broadcast(Info);
 }
 
 void UAttributeMenuWidgetController::BroadcastInitialvalues()
 {
-	UAuraAttributeSet* AS = CastChecked<UAuraAttributeSet>(AttributeSet);
 	check(AttributeInfo)
 
-	for (auto& Pair : AS->TagsToAttribute)
+	for (int32 Index = 0; Index < static_cast<int32>(EAuraAttribute::Count); ++Index)
 	{
-		BroadcastAttributeInfo(Pair.Key, Pair.Value());
+		BroadcastAttributeInfo(static_cast<EAuraAttribute>(Index));
 	}
 }
 
 void UAttributeMenuWidgetController::BindCallbacksToDependencies()
 {
-	UAuraAttributeSet* AS = CastChecked<UAuraAttributeSet>(AttributeSet);
 	check(AttributeInfo)
 
-	for (auto& Pair : AS->TagsToAttribute)
+	for (const FAuraAttributeDescriptor& Descriptor : UAuraAttributeSet::GetAttributeDescriptors())
 	{
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Pair.Value()).AddLambda(
-		[this, Pair](const FOnAttributeChangeData& Data)
+		if (!Descriptor.HasTag()) continue;
+
+		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Descriptor.Attribute).AddLambda(
+		[this](const FOnAttributeChangeData& Data)
 		{
-			BroadcastAttributeInfo(Pair.Key, Pair.Value());
+			MarkAttributeDirty(Data.Attribute);
 		}
 		);
 	}
 
 
 }
+
+void UAttributeMenuWidgetController::BroadcastDirtyAttribute(const FGameplayAttribute& Attribute, float NewValue)
+{
+	const EAuraAttribute AuraAttribute = UAuraAttributeSet::FindAuraAttribute(Attribute);
+	if (AuraAttribute != EAuraAttribute::None)
+	{
+		BroadcastAttributeInfo(AuraAttribute);
+	}
+}
@@ -1,5 +1,9 @@
 
 #include "UI/WidgetController/AuraWidgetController.h"
+#include "AbilitySystemComponent.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
 
 void UAuraWidgetController::SetWidgetControllerParams(const FWidgetControllerParams& WCParams)
 {
@@ -17,3 +21,45 @@ void UAuraWidgetController::BroadcastInitialvalues()
 void UAuraWidgetController::BindCallbacksToDependencies()
 {
 }
+
+void UAuraWidgetController::MarkAttributeDirty(const FGameplayAttribute& Attribute)
+{
+	DirtyAttributes.AddUnique(Attribute);
+
+	UWorld* World = PlayerController ? PlayerController->GetWorld() : nullptr;
+	if (World == nullptr)
+	{
+		FlushDirtyAttributes();
+		return;
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	if (TimerManager.TimerExists(FlushDirtyAttributesTimer)) return;
+
+	if (AttributeBroadcastInterval > 0.f)
+	{
+		TimerManager.SetTimer(FlushDirtyAttributesTimer, this, &UAuraWidgetController::FlushDirtyAttributes, AttributeBroadcastInterval, false);
+	}
+	else
+	{
+		FlushDirtyAttributesTimer = TimerManager.SetTimerForNextTick(this, &UAuraWidgetController::FlushDirtyAttributes);
+	}
+}
+
+void UAuraWidgetController::BroadcastDirtyAttribute(const FGameplayAttribute& Attribute, float NewValue)
+{
+}
+
+void UAuraWidgetController::FlushDirtyAttributes()
+{
+	FlushDirtyAttributesTimer.Invalidate();
+	if (AbilitySystemComponent == nullptr) return;
+
+	// Broadcasting can dirty attributes again, those go out on the next flush
+	TArray<FGameplayAttribute> AttributesToBroadcast = MoveTemp(DirtyAttributes);
+	DirtyAttributes.Reset();
+	for (const FGameplayAttribute& Attribute : AttributesToBroadcast)
+	{
+		BroadcastDirtyAttribute(Attribute, AbilitySystemComponent->GetNumericAttribute(Attribute));
+	}
+}
@@ -3,6 +3,11 @@
 #include "AbilitySystem/AuraAttributeSet.h"
 #include "GameplayTagContainer.h"
 
+static TAutoConsoleVariable<bool> CVarAuraDebugMessageTags(
+	TEXT("Aura.UI.DebugMessageTags"),
+	false,
+	TEXT("Prints every message tag routed to the overlay."));
+
 void UOverlayWidgetController::BroadcastInitialvalues()
 {
 	const UAuraAttributeSet* AuraAttributeSet = CastChecked<UAuraAttributeSet>(AttributeSet);
@@ -14,54 +19,76 @@ void UOverlayWidgetController::BroadcastInitialvalues()
 
 void UOverlayWidgetController::BindCallbacksToDependencies()
 {
-	const UAuraAttributeSet* AuraAttributeSet = CastChecked<UAuraAttributeSet>(AttributeSet);
-
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AuraAttributeSet->GetHealthAttribute()).AddLambda(
+	// Los cambios se acumulan y se envian a los widgets una vez por frame (ver BroadcastDirtyAttribute)
+	for (const EAuraAttribute AuraAttribute : { EAuraAttribute::Health, EAuraAttribute::MaxHealth, EAuraAttribute::Mana, EAuraAttribute::MaxMana })
+	{
+		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(UAuraAttributeSet::GetAttributeDescriptor(AuraAttribute).Attribute).AddLambda(
 			[this](const FOnAttributeChangeData& Data)
 			{
-				OnHealthChanged.Broadcast(Data.NewValue);
+				MarkAttributeDirty(Data.Attribute);
 			}
 		);
+	}
 
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AuraAttributeSet->GetMaxHealthAttribute()).AddLambda(
-		[this](const FOnAttributeChangeData& Data)
-		{
-			OnMaxHealthChanged.Broadcast(Data.NewValue);
-		}
-	);
+	BuildMessageRoutes();
+	if (MessageWidgetDataTable && !MessageTableChangedHandle.IsValid())
+	{
+		MessageTableChangedHandle = MessageWidgetDataTable->OnDataTableChanged().AddUObject(this, &UOverlayWidgetController::BuildMessageRoutes);
+	}
 
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AuraAttributeSet->GetManaAttribute()).AddLambda(
-		[this](const FOnAttributeChangeData& Data)
-		{
-			OnManaChanged.Broadcast(Data.NewValue);
-		}
-	);
+	Cast<UAuraAbilitySystemComponent>(AbilitySystemComponent)->EffectAssetTags.AddUObject(this, &UOverlayWidgetController::BroadcastMessages);
+}
 
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AuraAttributeSet->GetMaxManaAttribute()).AddLambda(
-		[this](const FOnAttributeChangeData& Data)
+void UOverlayWidgetController::BuildMessageRoutes()
+{
+	MessageRoutes.Reset();
+	if (MessageWidgetDataTable == nullptr) return;
+
+	const FGameplayTag MessageTag = FGameplayTag::RequestGameplayTag(FName("Message"));
+	for (const TPair<FName, uint8*>& RowPair : MessageWidgetDataTable->GetRowMap())
+	{
+		// Rows are named after their tag, same as GetDataTableRowByTag.
+		const FGameplayTag RowTag = FGameplayTag::RequestGameplayTag(RowPair.Key, false);
+		const FUIWidgetRow* Row = MessageWidgetDataTable->FindRow<FUIWidgetRow>(RowPair.Key, TEXT(""), false);
+		if (Row && RowTag.MatchesTag(MessageTag))
 		{
-			OnMaxManaChanged.Broadcast(Data.NewValue);
+			MessageRoutes.Add(RowTag, *Row);
 		}
-	);
+	}
+}
 
-	Cast<UAuraAbilitySystemComponent>(AbilitySystemComponent)->EffectAssetTags.AddLambda(
+void UOverlayWidgetController::BroadcastMessages(const FGameplayTagContainer& AssetTags) const
+{
+	for (const FGameplayTag& Tag : AssetTags)
+	{
+		const FUIWidgetRow* Row = MessageRoutes.Find(Tag);
+		if (Row == nullptr) continue;
 
-		[this](const FGameplayTagContainer& AssetTags)
+		if (CVarAuraDebugMessageTags.GetValueOnGameThread() && GEngine)
 		{
-			for (const FGameplayTag& Tag : AssetTags)
-			{
-				FGameplayTag MessageTag = FGameplayTag::RequestGameplayTag(FName("Message"));
-				if (Tag.MatchesTag(MessageTag))
-				{
-					
-					const FString Msj = FString::Printf(TEXT("GE Tag: %s"), *Tag.ToString());
-					GEngine->AddOnScreenDebugMessage(-1, 8.f, FColor::Blue, Msj);
-
-					const FUIWidgetRow* Row = GetDataTableRowByTag<FUIWidgetRow>(MessageWidgetDataTable, Tag);
-					MessageWidgetRow.Broadcast(*Row);
-				}
-			}		
+			GEngine->AddOnScreenDebugMessage(-1, 8.f, FColor::Blue, FString::Printf(TEXT("GE Tag: %s"), *Tag.ToString()));
 		}
-	);
+		MessageWidgetRow.Broadcast(*Row);
+	}
 }
 
+void UOverlayWidgetController::BroadcastDirtyAttribute(const FGameplayAttribute& Attribute, float NewValue)
+{
+	switch (UAuraAttributeSet::FindAuraAttribute(Attribute))
+	{
+	case EAuraAttribute::Health:
+		OnHealthChanged.Broadcast(NewValue);
+		break;
+	case EAuraAttribute::MaxHealth:
+		OnMaxHealthChanged.Broadcast(NewValue);
+		break;
+	case EAuraAttribute::Mana:
+		OnManaChanged.Broadcast(NewValue);
+		break;
+	case EAuraAttribute::MaxMana:
+		OnMaxManaChanged.Broadcast(NewValue);
+		break;
+	default:
+		break;
+	}
+}
@@ -18,4 +18,16 @@ protected:
 	
 	UPROPERTY(EditDefaultsOnly, Category = "Damage")
 	TMap<FGameplayTag, FScalableFloat> DamageTypes;
+
+	/** Outgoing DamageEffectClass spec with every DamageTypes entry assigned as a SetByCaller magnitude. */
+	FGameplayEffectSpecHandle MakeDamageEffectSpecHandle(UObject* SourceObject) const;
+
+	/** Damages all targets with one spec through the batched mitigation path, for AoE abilities. */
+	UFUNCTION(BlueprintCallable, Category = "Damage")
+	void CauseDamageToTargets(const TArray<AActor*>& TargetActors);
+
+public:
+
+	/** Server side seed from the combat stream, for damage spec rolls and batched projectile spread. See Aura.Combat.SeedOverride. */
+	static int32 MakeCombatSeed();
 };
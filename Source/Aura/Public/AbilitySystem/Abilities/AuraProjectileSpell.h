@@ -22,5 +22,17 @@ protected:
 	
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	TSubclassOf<AAuraProjectile> ProjectileClass;
+
+	/** Projectiles of ProjectileClass kept ready in the world's projectile pool. */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile", meta = (ClampMin = 0))
+	int32 PoolPrewarmCount = 8;
+
+	/** Simulates projectiles in AAuraProjectileManager instead of spawning actors, for high volume spells. */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile")
+	bool bUseBatchedProjectiles = false;
+
+	/** Random spread cone of batched projectiles, in degrees. */
+	UPROPERTY(EditDefaultsOnly, Category = "Projectile", meta = (ClampMin = 0, ClampMax = 180, EditCondition = "bUseBatchedProjectiles"))
+	float BatchedSpreadDegrees = 0.f;
 	
 };
@@ -7,6 +7,8 @@
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FEffectAssetTags, const FGameplayTagContainer&);
 
+enum class EAuraAttribute : uint8;
+
 
 UCLASS()
 class AURA_API UAuraAbilitySystemComponent : public UAbilitySystemComponent
@@ -15,8 +17,16 @@ class AURA_API UAuraAbilitySystemComponent : public UAbilitySystemComponent
 
 protected:
 
+	/** Server only. Queues the asset tags of EffectSpec that pass ClientEffectTagQuery. */
+	void OnEffectAppliedToSelf(UAbilitySystemComponent* AbilitySystemComponent, const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle);
+
+	// One RPC per frame with the tags of every effect applied that frame (net indexed with FastReplication).
 	UFUNCTION(Client, Reliable)
-	void ClientEffectApplied(UAbilitySystemComponent* AbilitySystemComponent, const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle);
+	void ClientEffectAssetTags(const TArray<FGameplayTag>& AssetTags);
+
+	/** Asset tags that reach the client's EffectAssetTags. Empty means Message.* */
+	UPROPERTY(EditDefaultsOnly, Category = "Effects")
+	FGameplayTagQuery ClientEffectTagQuery;
 
 public:
 
@@ -27,6 +37,81 @@ public:
 	void AbilityInputTagHeld(const FGameplayTag& InputTag);
 	void AbilityInputTagReleased(const FGameplayTag& InputTag);
 
+	/**
+	 * Input dispatch rebuilds its index when a spec is marked with MarkAbilitySpecDirty, which spec edits need anyway to replicate.
+	 * Only call this after changing the DynamicAbilityTags of a spec that isn't marked.
+	 */
+	void MarkInputTagIndexDirty() { bInputTagIndexDirty = true; }
+
+	/*
+	* Attribute values evaluated by UExecCalc_Damage with this ASC as target, shared by every execution until the attribute changes.
+	* Values are kept per source/target tag context: TagsHash picks the candidates and the containers are compared before reuse.
+	* A change of an attribute only invalidates the values of that attribute, through its change count.
+	*/
+	bool FindAttributeSnapshot(EAuraAttribute Attribute, uint32 TagsHash, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, float& OutValue);
+	void StoreAttributeSnapshot(EAuraAttribute Attribute, uint32 TagsHash, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, float Value);
+
 	FEffectAssetTags EffectAssetTags;
+
+protected:
+
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRep_ActivateAbilities() override;
+
+private:
+
+	// Position of a spec in ActivatableAbilities.Items, checked against its handle before use.
+	struct FInputTagSpecRef
+	{
+		int32 Index = INDEX_NONE;
+		FGameplayAbilitySpecHandle Handle;
+	};
+
+	using FInputTagSpecRefs = TArray<FInputTagSpecRef, TInlineAllocator<2>>;
+
+	/** Specs whose DynamicAbilityTags contain InputTag, rebuilding the index first when it's dirty or stale. */
+	FInputTagSpecRefs GetSpecsForInputTag(const FGameplayTag& InputTag);
+	void RebuildInputTagIndex();
+	bool IsInputTagSpecRefValid(const FInputTagSpecRef& SpecRef, const FGameplayTag& InputTag) const;
+
+	TMap<FGameplayTag, FInputTagSpecRefs> InputTagIndex;
+	bool bInputTagIndexDirty = true;
+
+	// ActivatableAbilities.ArrayReplicationKey when the index was built, MarkAbilitySpecDirty bumps it.
+	int32 InputTagIndexReplicationKey = INDEX_NONE;
+
+	void FlushClientEffectAssetTags();
+
+	TArray<FGameplayTag> PendingClientEffectAssetTags;
+	FTimerHandle FlushClientEffectAssetTagsTimer;
+
+	struct FAttributeSnapshot
+	{
+		uint32 TagsHash = 0;
+		FGameplayTagContainer SourceTags;
+		FGameplayTagContainer TargetTags;
+
+		struct FValue
+		{
+			EAuraAttribute Attribute;
+			// AttributeChangeCounts of Attribute when Value was evaluated.
+			uint32 ChangeCount = 0;
+			float Value = 0.f;
+		};
+		TArray<FValue, TInlineAllocator<8>> Values;
+	};
+
+	FAttributeSnapshot* FindAttributeSnapshotContext(uint32 TagsHash, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags);
+	void OnSnapshotAttributeChanged(const FOnAttributeChangeData& Data);
+
+	// One entry per tag context, started over once MaxAttributeSnapshots contexts are in use.
+	TArray<FAttributeSnapshot> AttributeSnapshots;
+
+	// Bumped by OnSnapshotAttributeChanged, indexed by EAuraAttribute.
+	TArray<uint32, TInlineAllocator<32>> AttributeChangeCounts;
+
+	// Attributes whose change delegate already drops the snapshot, one bit per EAuraAttribute.
+	uint32 SnapshotBoundAttributes = 0;
 	
 };
@@ -7,6 +7,7 @@
 #include "AuraAbilitySystemLibrary.generated.h"
 
 struct FGameplayEffectContextHandle;
+struct FGameplayEffectSpecHandle;
 class UOverlayWidgetController;
 class UAttributeMenuWidgetController;
 
@@ -44,5 +45,23 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "AuraAbilitySystemLibrary|CharacterClassDefaults")
 	static void SetIsCriticalHit(UPARAM(ref) FGameplayEffectContextHandle& EffectContextHandle, bool bInIsCritical);
+
+	UFUNCTION(BlueprintCallable, Category = "AuraAbilitySystemLibrary|Damage")
+	static void SetCombatSeed(UPARAM(ref) FGameplayEffectContextHandle& EffectContextHandle, int32 InCombatSeed);
+
+	/** Deterministic roll in [0, 1) from the context's combat seed and RollIndex. */
+	UFUNCTION(BlueprintPure, Category = "AuraAbilitySystemLibrary|Damage")
+	static float RollCombatRandom(const FGameplayEffectContextHandle& EffectContextHandle, int32 RollIndex);
+
+	/** Index of Target in the context's replicated actors, 0 when it isn't listed. Part of the roll index of each target. */
+	UFUNCTION(BlueprintPure, Category = "AuraAbilitySystemLibrary|Damage")
+	static int32 GetCombatTargetIndex(const FGameplayEffectContextHandle& EffectContextHandle, const AActor* Target);
+
+	/*
+	 * Mitigates one damage spec against every target in a single batch and commits the damage to each target's attribute set,
+	 * without a gameplay effect application per target. Specs that do more than UExecCalc_Damage are applied to each target instead.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AuraAbilitySystemLibrary|Damage")
+	static void ApplyDamageEffectToTargets(const FGameplayEffectSpecHandle& DamageEffectSpecHandle, const TArray<AActor*>& TargetActors);
 	
 };
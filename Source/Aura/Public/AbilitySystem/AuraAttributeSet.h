@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "AttributeSet.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
+#include "AuraGameplayTags.h"
 #include "AuraAttributeSet.generated.h"
 
 #define ATTRIBUTE_ACCESSORS(ClassName, PropertyName) \
@@ -12,6 +13,61 @@ GAMEPLAYATTRIBUTE_VALUE_GETTER(PropertyName) \
 GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
 GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
 
+/*
+* Registro de atributos replicados: X(Name, TagMember, RepCondition, ClampMax)
+* Name must match the UPROPERTY and its OnRep_Name, ClampMax is None when the attribute is not clamped.
+* Health and MaxHealth are COND_Dynamic: everyone gets them for avatars with a health bar (see SetVitalsReplicatedToAll),
+* the rest is only ever shown to the owner.
+* UHT can't see through macros, so the UPROPERTY/UFUNCTION declarations below stay hand-written.
+*/
+#define AURA_ATTRIBUTES(X) \
+	X(Strength, &FAuraGameplayTags::Attribute_Primary_Strength, COND_OwnerOnly, None) \
+	X(Intelligence, &FAuraGameplayTags::Attribute_Primary_Intelligence, COND_OwnerOnly, None) \
+	X(Resilience, &FAuraGameplayTags::Attribute_Primary_Resilience, COND_OwnerOnly, None) \
+	X(Vigor, &FAuraGameplayTags::Attribute_Primary_Vigor, COND_OwnerOnly, None) \
+	X(Health, nullptr, COND_Dynamic, MaxHealth) \
+	X(Mana, nullptr, COND_OwnerOnly, MaxMana) \
+	X(Armor, &FAuraGameplayTags::Attribute_Secondary_Armor, COND_OwnerOnly, None) \
+	X(ArmorPenetration, &FAuraGameplayTags::Attribute_Secondary_ArmorPenetration, COND_OwnerOnly, None) \
+	X(BlockChance, &FAuraGameplayTags::Attribute_Secondary_BlockChance, COND_OwnerOnly, None) \
+	X(CriticalHitChance, &FAuraGameplayTags::Attribute_Secondary_CriticalHitChance, COND_OwnerOnly, None) \
+	X(CriticalHitDamage, &FAuraGameplayTags::Attribute_Secondary_CriticalHitDamage, COND_OwnerOnly, None) \
+	X(CriticalHitResistance, &FAuraGameplayTags::Attribute_Secondary_CriticalHitResistance, COND_OwnerOnly, None) \
+	X(HealthRegeneration, &FAuraGameplayTags::Attribute_Secondary_HealthRegeneration, COND_OwnerOnly, None) \
+	X(ManaRegeneration, &FAuraGameplayTags::Attribute_Secondary_ManaRegeneration, COND_OwnerOnly, None) \
+	X(MaxHealth, &FAuraGameplayTags::Attribute_Secondary_MaxHealth, COND_Dynamic, None) \
+	X(MaxMana, &FAuraGameplayTags::Attribute_Secondary_MaxMana, COND_OwnerOnly, None) \
+	X(FireResistance, &FAuraGameplayTags::Attribute_Resistance_Fire, COND_OwnerOnly, None) \
+	X(ArcaneResistance, &FAuraGameplayTags::Attribute_Resistance_Arcane, COND_OwnerOnly, None) \
+	X(LightningResistance, &FAuraGameplayTags::Attribute_Resistance_Lightning, COND_OwnerOnly, None) \
+	X(PhysicalResistance, &FAuraGameplayTags::Attribute_Resistance_Physical, COND_OwnerOnly, None)
+
+/** Dense index of every replicated attribute, in AURA_ATTRIBUTES order. */
+enum class EAuraAttribute : uint8
+{
+#define AURA_ATTRIBUTE_ENUM(Name, TagMember, RepCondition, ClampMax) Name,
+	AURA_ATTRIBUTES(AURA_ATTRIBUTE_ENUM)
+#undef AURA_ATTRIBUTE_ENUM
+	Count,
+	None = Count
+};
+
+struct FAuraAttributeDescriptor
+{
+	FGameplayAttribute Attribute;
+
+	// Member of FAuraGameplayTags, resolved on access so the registry doesn't depend on tag init order.
+	FGameplayTag FAuraGameplayTags::* TagMember = nullptr;
+
+	ELifetimeCondition RepCondition = COND_None;
+
+	// Upper clamp for the value, [0, ClampMax].
+	EAuraAttribute ClampMax = EAuraAttribute::None;
+
+	bool HasTag() const { return TagMember != nullptr; }
+	const FGameplayTag& GetTag() const { return TagMember ? FAuraGameplayTags::Get().*TagMember : FGameplayTag::EmptyTag; }
+};
+
 USTRUCT()
 
 struct FEffectProperties 
@@ -50,14 +106,6 @@ struct FEffectProperties
 
 };
 
-//typedef TBaseStaticDelegateInstance<FGameplayAttribute(), FDefaultDelegateUserPolicy>::FFuncPtr AttributeFuncPtr;
- 
-template<class T>
-using TStaticFuncPtr = typename TBaseStaticDelegateInstance<T, FDefaultDelegateUserPolicy>::FFuncPtr;
-
-//typedef is specific to the FGameplayAttribute() signature, but TStaticFuncPtr is generic to any signature chosen
-//typedef TBaseStaticDelegateInstance<FGameplayAttribute(),  FDefaultDelegateUserPolicy>::FFuncPtr;
-
 UCLASS()
 class AURA_API UAuraAttributeSet : public UAttributeSet
 {
@@ -66,8 +114,16 @@ class AURA_API UAuraAttributeSet : public UAttributeSet
 private:
 
 	void SetEffectProperties(const FGameplayEffectModCallbackData& Data, FEffectProperties& Props) const;
+	void SetEffectProperties(const FGameplayEffectContextHandle& SourceEffectContextHandle, UAbilitySystemComponent& TargetASC, FEffectProperties& Props) const;
+	void HandleIncomingDamage(const FEffectProperties& Props, float Damage, bool bIsBlockedHit, bool bIsCriticalHit);
 	void ShowFloatingText(const FEffectProperties& Props, const float Damage, bool bIsBlockedHit, bool bIsCriticalHit) const;
 
+	// Clamps NewValue to [0, ClampMax] when the registry defines one for AuraAttribute.
+	bool ClampAttributeValue(EAuraAttribute AuraAttribute, float& NewValue) const;
+
+	// Attributes replicate push based, every change has to go through here.
+	void MarkAttributeReplicationDirty(EAuraAttribute AuraAttribute) const;
+
 public:
 
 	UAuraAttributeSet();
@@ -77,13 +133,26 @@ public:
 
 	virtual void PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data) override;
 
-	//TMap<FGameplayTag, TBaseStaticDelegateInstance<FGameplayAttribute(), FDefaultDelegateUserPolicy>::FFuncPtr> TagsToAttribute;
-	// 
-	//TMap<FGameplayTag, FGameplayAttribute(*)()> TagsToAttribute;
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+
+	virtual void PostAttributeBaseChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) const override;
+
+	/** Commits damage already mitigated by UAuraAbilitySystemLibrary::ApplyDamageEffectToTargets, like an IncomingDamage execution would. */
+	void ApplyMitigatedDamage(float Damage, const FGameplayEffectContextHandle& SourceEffectContextHandle, bool bIsBlockedHit, bool bIsCriticalHit);
+
+	/** Server only. COND_Dynamic attributes replicate to everyone (the default, for health bars) or only to the owner. */
+	void SetVitalsReplicatedToAll(bool bReplicatedToAll);
+
+	/** Contiguous descriptor array indexed by EAuraAttribute. */
+	static TConstArrayView<FAuraAttributeDescriptor> GetAttributeDescriptors();
 
-	TMap<FGameplayTag, TStaticFuncPtr<FGameplayAttribute()>> TagsToAttribute;
+	static const FAuraAttributeDescriptor& GetAttributeDescriptor(EAuraAttribute AuraAttribute)
+	{
+		return GetAttributeDescriptors()[static_cast<int32>(AuraAttribute)];
+	}
 
-	//TBaseStaticDelegateInstance<FGameplayAttribute(), FDefaultDelegateUserPolicy>::FFuncPtr FunctionPointer;
+	/** Registry index of Attribute, None for attributes outside the registry (meta attributes). */
+	static EAuraAttribute FindAuraAttribute(const FGameplayAttribute& Attribute);
 
 	/*
 	* primary attributes
@@ -0,0 +1,49 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+#define AURA_COMBAT_TRACE !UE_BUILD_SHIPPING
+
+/*
+ * One damage execution, stored as plain data so recording never formats strings.
+ */
+struct FAuraCombatTraceRecord
+{
+	static constexpr int32 MaxDamageTypes = 8;
+
+	uint64 FrameNumber = 0;
+	FWeakObjectPtr Source;
+	FWeakObjectPtr Target;
+	float DamageByType[MaxDamageTypes] = {};
+	float FinalDamage = 0.f;
+	bool bIsBlockedHit = false;
+	bool bIsCriticalHit = false;
+};
+
+#if AURA_COMBAT_TRACE
+
+/*
+ * Opt-in ring buffer of damage executions (Aura.Combat.Trace 1), dumped to Saved/CombatTrace with Aura.Combat.DumpTrace.
+ * Game thread only.
+ */
+class AURA_API FAuraCombatTrace
+{
+public:
+
+	static bool IsEnabled();
+
+	static void Record(const FAuraCombatTraceRecord& Record);
+
+	/** Writes the buffered records, oldest first, to a binary file. Returns false if the file couldn't be written. */
+	static bool Dump(const FString& Filename);
+
+private:
+
+	static TArray<FAuraCombatTraceRecord> Records;
+	static int32 NextRecordIndex;
+	static int32 Capacity;
+};
+
+#endif
@@ -31,9 +31,23 @@ class AURA_API UAttributeInfoDataAsset : public UDataAsset
 
 public:
 
-	FAuraAttributeInfo FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound = false) const;
+	/** Hashed lookup. Returns a default constructed info when AttributeTag isn't in AttributeInformation. */
+	const FAuraAttributeInfo& FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound = false) const;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	TArray<FAuraAttributeInfo> AttributeInformation;
 
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+
+	void BuildAttributeInfoIndex() const;
+
+	// AttributeTag -> index in AttributeInformation.
+	mutable TMap<FGameplayTag, int32> AttributeInfoIndex;
+
 };
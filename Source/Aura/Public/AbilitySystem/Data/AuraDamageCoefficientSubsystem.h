@@ -0,0 +1,38 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraDamageCoefficientSubsystem.generated.h"
+
+class UCharacterClassInfo;
+struct FAuraDamageCoefficients;
+
+/*
+ * Keeps the game mode's UCharacterClassInfo at hand so damage executions read its baked coefficients
+ * without going through UGameplayStatics::GetGameMode on every hit.
+ */
+UCLASS()
+class AURA_API UAuraDamageCoefficientSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Baked damage coefficients of the world's character class info, nullptr when the game mode has none. */
+	static const FAuraDamageCoefficients* FindDamageCoefficients(const UObject* WorldContextObject);
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+
+	const UCharacterClassInfo* GetCharacterClassInfo();
+
+	UPROPERTY()
+	TObjectPtr<const UCharacterClassInfo> CharacterClassInfo;
+};
@@ -7,6 +7,7 @@
 
 class UGameplayAbility;
 class UGameplayEffect;
+class UCurveTable;
 
 UENUM(BlueprintType)
 enum class ECharacterClass : uint8
@@ -29,6 +30,35 @@ struct FCharacterClassDefaultInfo
 	
 };
 
+/*
+ * DamageCalculationCoefficients curves baked into flat arrays indexed by level.
+ * Levels past the last baked entry reuse it, matching the curves' constant extrapolation.
+ */
+struct FAuraDamageCoefficients
+{
+	TArray<float> ArmorPenetration;
+	TArray<float> EffectiveArmor;
+	TArray<float> CriticalHitResistance;
+
+	float GetArmorPenetration(int32 Level) const { return GetAtLevel(ArmorPenetration, Level); }
+	float GetEffectiveArmor(int32 Level) const { return GetAtLevel(EffectiveArmor, Level); }
+	float GetCriticalHitResistance(int32 Level) const { return GetAtLevel(CriticalHitResistance, Level); }
+
+	void Reset()
+	{
+		ArmorPenetration.Reset();
+		EffectiveArmor.Reset();
+		CriticalHitResistance.Reset();
+	}
+
+private:
+
+	static float GetAtLevel(const TArray<float>& Values, int32 Level)
+	{
+		return Values.Num() > 0 ? Values[FMath::Clamp(Level, 0, Values.Num() - 1)] : 0.f;
+	}
+};
+
 UCLASS()
 class AURA_API UCharacterClassInfo : public UDataAsset
 {
@@ -38,7 +68,7 @@ public:
 
 	UPROPERTY(EditDefaultsOnly, Category = "Class Defaults")
 	TMap<ECharacterClass, FCharacterClassDefaultInfo> CharacterClassInformation;
-	
+
 	UPROPERTY(EditDefaultsOnly, Category = "Common Class Defaults")
 	TSubclassOf<UGameplayEffect> SecondaryAttributes;
 
@@ -52,5 +82,28 @@ public:
 	TObjectPtr<UCurveTable> DamageCalculationCoefficients;
 
 	FCharacterClassDefaultInfo GetClassDefaultInfo(ECharacterClass CharacterClass);
-	
+
+	/** Baked damage coefficients, rebuilt only after DamageCalculationCoefficients changes or reloads. */
+	const FAuraDamageCoefficients& GetDamageCoefficients() const;
+
+	virtual void PostLoad() override;
+	virtual void BeginDestroy() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+
+	void BakeDamageCoefficients() const;
+	void InvalidateDamageCoefficients();
+	void BindCurveTableChanged();
+	void UnbindCurveTableChanged();
+
+	mutable FAuraDamageCoefficients DamageCoefficients;
+	mutable bool bDamageCoefficientsDirty = true;
+
+	TWeakObjectPtr<UCurveTable> BoundCurveTable;
+	FDelegateHandle CurveTableChangedHandle;
+
 };
@@ -5,6 +5,96 @@
 #include "GameplayEffectExecutionCalculation.h"
 #include "ExecCalc_Damage.generated.h"
 
+class UAbilitySystemComponent;
+
+/*
+ * Damage formula shared by the single target execution and the batched multi-target path.
+ */
+namespace AuraDamage
+{
+	constexpr float BlockDamageReductionFactor = 0.5f;
+	constexpr float CriticalHitDamageFactor = 2.f;
+
+	// Rolls of one execution, fed to the context's combat seed through GetRollIndex.
+	constexpr int32 BlockRollIndex = 0;
+	constexpr int32 CriticalRollIndex = 1;
+	constexpr int32 NumRollsPerTarget = 2;
+	constexpr int32 MaxTargetsPerPeriod = 1024;
+
+	/*
+	 * Roll index from replicated data only: the target's index in the context's actors and, for periodic effects, the
+	 * period being executed. Each target and period rolls differently, and a client holding the context rolls the same.
+	 */
+	FORCEINLINE int32 GetRollIndex(int32 TargetIndex, int32 PeriodIndex, int32 Roll)
+	{
+		const uint32 Execution = static_cast<uint32>(PeriodIndex) * MaxTargetsPerPeriod + static_cast<uint32>(TargetIndex % MaxTargetsPerPeriod);
+		return static_cast<int32>(Execution * NumRollsPerTarget + static_cast<uint32>(Roll));
+	}
+
+	FORCEINLINE float ApplyResistance(float DamageTypeValue, float Resistance)
+	{
+		return DamageTypeValue * (100.f - FMath::Clamp(Resistance, 0.f, 100.f)) / 100.f;
+	}
+
+	FORCEINLINE bool IsBlocked(float BlockChance, float Roll)
+	{
+		return Roll < FMath::Clamp(BlockChance / 100.f, 0.f, 1.f);
+	}
+
+	//ArmorPenetration ignores a percentage of the targets armor.
+	FORCEINLINE float GetEffectiveArmor(float Armor, float ArmorPenetration, float ArmorPenetrationCoefficient)
+	{
+		return Armor * (100 - ArmorPenetration * ArmorPenetrationCoefficient) / 100.f;
+	}
+
+	//Armor Ignores a percentage of incoming damage.
+	FORCEINLINE float ApplyArmor(float Damage, float EffectiveArmor, float EffectiveArmorCoefficient)
+	{
+		return Damage * (100 - EffectiveArmor * EffectiveArmorCoefficient) / 100.f;
+	}
+
+	FORCEINLINE bool IsCritical(float CriticalHitChance, float CriticalHitResistance, float CriticalHitResistanceCoefficient, float Roll)
+	{
+		const float NormalizedCriticalHitChance = FMath::Clamp(CriticalHitChance / 100.f, 0.f, 1.f);
+		const float NormalizedCriticalHitResistance = FMath::Clamp(CriticalHitResistance / 100.f, 0.f, 1.f);
+		return Roll * CriticalHitResistanceCoefficient + NormalizedCriticalHitResistance < NormalizedCriticalHitChance;
+	}
+}
+
+/*
+ * Inputs and results of a batched damage calculation, one array entry per target.
+ * Resistances holds one array per entry of FAuraGameplayTags::DamageTypesToResistances, in AURA_DAMAGE_TYPES order.
+ */
+struct FAuraDamageBatch
+{
+	TArray<UAbilitySystemComponent*> TargetASCs;
+
+	// Position of each target in the TargetASCs passed to CalculateDamageBatch, used as its roll target index.
+	TArray<int32> TargetIndex;
+
+	TArray<float> Armor;
+	TArray<float> BlockChance;
+	TArray<float> CriticalHitResistance;
+	TArray<float> EffectiveArmorCoefficient;
+	TArray<float> CriticalHitResistanceCoefficient;
+	TArray<TArray<float>> Resistances;
+
+	// Source attributes, evaluated against each target's tags.
+	TArray<float> ArmorPenetration;
+	TArray<float> CriticalHitChance;
+	TArray<float> CriticalHitDamage;
+
+	TArray<float> BlockRoll;
+	TArray<float> CriticalRoll;
+
+	TArray<float> Damage;
+	TArray<bool> bIsBlockedHit;
+	TArray<bool> bIsCriticalHit;
+
+	int32 Num() const { return TargetASCs.Num(); }
+	void SetNum(int32 NumTargets, int32 NumDamageTypes);
+};
+
 UCLASS()
 class AURA_API UExecCalc_Damage : public UGameplayEffectExecutionCalculation
 {
@@ -15,5 +105,15 @@ public:
 	UExecCalc_Damage();
 
 	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
-	
+
+	/** True when applying Spec does nothing but this execution's IncomingDamage, so the batch can commit it directly. */
+	static bool SupportsDamageBatch(const FGameplayEffectSpec& Spec);
+
+	/*
+	 * Computes mitigated damage of Spec against every target in one pass.
+	 * Attributes are evaluated through the captured aggregators with the same tags as the single target execution.
+	 * Returns false, with an empty batch, when the source has no combat interface or there is no character class info.
+	 */
+	static bool CalculateDamageBatch(const FGameplayEffectSpec& Spec, const TArray<UAbilitySystemComponent*>& TargetASCs, FAuraDamageBatch& OutBatch);
+
 };
@@ -9,6 +9,29 @@
 class USphereComponent;
 class UProjectileMovementComponent;
 class UNiagaraSystem;
+class UAuraProjectilePoolSubsystem;
+
+/*
+ * Replicated pool state of a projectile. Clients re-simulate from Location/Rotation each time the projectile is reused.
+ */
+USTRUCT()
+struct FAuraProjectileActivation
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	bool bActive = true;
+
+	// Bumped on every activation so reusing a projectile on the same spot still triggers OnRep.
+	UPROPERTY()
+	uint8 ActivationCount = 0;
+
+	UPROPERTY()
+	FVector_NetQuantize Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+};
 
 UCLASS()
 class AURA_API AAuraProjectile : public AActor
@@ -29,11 +52,39 @@ private:
 	UPROPERTY(EditAnywhere)
 	TObjectPtr<USoundBase> HissSound;
 
+	/** Drawn by AAuraProjectileManager for batched projectiles of this class. Reads positions from the User.Positions vector array. */
+	UPROPERTY(EditAnywhere, Category = "Batched")
+	TObjectPtr<UNiagaraSystem> BatchedVisualSystem;
+
 	UPROPERTY()
 	UAudioComponent* AttachedHissSound;
 
 	bool bHit = false;
 
+	// Set by UAuraProjectilePoolSubsystem. Pooled projectiles are released on hit/lifespan instead of destroyed.
+	bool bPooled = false;
+
+	// InitialLifeSpan of pooled projectiles, applied on every activation by a timer instead of the actor lifespan.
+	float PooledLifeSpan = 0.f;
+
+	FTimerHandle PooledLifeSpanTimer;
+
+	UPROPERTY(ReplicatedUsing = OnRep_Activation)
+	FAuraProjectileActivation Activation;
+
+	UFUNCTION()
+	void OnRep_Activation(const FAuraProjectileActivation& OldActivation);
+
+	void ApplyActivation();
+	void PlayImpactEffects();
+	void StartHissSound();
+	void StopHissSound();
+
+	/** Returns the projectile to its pool, or destroys it when it wasn't spawned by one. */
+	void Finish();
+
+	friend class UAuraProjectilePoolSubsystem;
+
 protected:
 
 	virtual void BeginPlay() override;
@@ -45,6 +96,20 @@ protected:
 public:
 	
 	AAuraProjectile();
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Server only. Moves the projectile to Transform and restarts its flight and lifespan. */
+	void ActivatePooled(const FTransform& Transform);
+
+	/** Server only. Hides the projectile and stops movement, collision and sounds until the next ActivatePooled, and puts it to sleep on the network. */
+	void DeactivatePooled();
+
+	bool IsActive() const { return Activation.bActive; }
+
+	float GetCollisionRadius() const;
+	UNiagaraSystem* GetImpactEffect() const { return ImpactEffect; }
+	USoundBase* GetImpactSound() const { return ImpactSound; }
+	UNiagaraSystem* GetBatchedVisualSystem() const { return BatchedVisualSystem; }
 
 	UPROPERTY(VisibleAnywhere)
 	TObjectPtr<UProjectileMovementComponent> ProjectileMovement;
@@ -0,0 +1,116 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "GameFramework/Info.h"
+#include "Engine/NetSerialization.h"
+#include "AuraProjectileManager.generated.h"
+
+class AAuraProjectile;
+class UNiagaraComponent;
+
+/*
+ * Everything clients need to simulate a batched projectile on their own. Spawns are multicast in groups per causer.
+ */
+USTRUCT()
+struct FAuraBatchedProjectileSpawn
+{
+	GENERATED_BODY()
+
+	// Index into AAuraProjectileManager::RegisteredClasses, source of speed, radius, lifespan, impact and visual assets.
+	UPROPERTY()
+	uint8 ClassIndex = 0;
+
+	UPROPERTY()
+	FVector_NetQuantize Origin = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction = FVector::ForwardVector;
+
+	// Drives the spread cone so server and clients pick the same direction.
+	UPROPERTY()
+	int32 Seed = 0;
+
+	UPROPERTY()
+	uint8 SpreadDegrees = 0;
+};
+
+/*
+ * Simulates projectiles without per projectile actors. World geometry along the straight flight path is swept once at
+ * spawn; every tick pawns are bucketed in a grid and only projectiles whose step overlaps a pawn cell are swept against
+ * pawns. The server applies damage on hit; only spawn events replicate and clients step their own copies for visuals
+ * and impacts.
+ */
+UCLASS(NotPlaceable)
+class AURA_API AAuraProjectileManager : public AInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	AAuraProjectileManager();
+
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Server only. Direction is spread by SpreadDegrees using a seed from the combat stream that is replicated with the spawn. */
+	void SpawnProjectile(TSubclassOf<AAuraProjectile> ProjectileClass, const FVector& Origin, const FVector& Direction, float SpreadDegrees, AActor* Causer, const FGameplayEffectSpecHandle& DamageEffectSpecHandle);
+
+	int32 Num() const { return Positions.Num(); }
+
+protected:
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+
+	// Visual only on clients, a lost spawn just isn't drawn.
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastSpawnProjectiles(AActor* Causer, const TArray<FAuraBatchedProjectileSpawn>& Spawns);
+
+	/** Server only. Index of ProjectileClass in RegisteredClasses, adding it on first use. INDEX_NONE when the registry is full. */
+	int32 RegisterProjectileClass(TSubclassOf<AAuraProjectile> ProjectileClass);
+
+	void AddProjectile(TSubclassOf<AAuraProjectile> ProjectileClass, const FAuraBatchedProjectileSpawn& Spawn, AActor* Causer, const FGameplayEffectSpecHandle& DamageEffectSpecHandle);
+	void RemoveProjectile(int32 Index);
+	void SendPendingSpawns();
+	void StepProjectiles(float DeltaSeconds);
+	void BuildPawnGrid();
+	bool HasPawnCandidate(const FBox& SweepBounds, const AActor* Causer) const;
+	void OnProjectileHit(int32 Index, const FHitResult& Hit);
+	void UpdateVisuals();
+
+	// Projectile classes spawned so far, in registration order. Spawns reference them by index.
+	UPROPERTY(Replicated)
+	TArray<TSubclassOf<AAuraProjectile>> RegisteredClasses;
+
+	// Spawns made this frame per causer, sent to clients on the next tick.
+	TMap<TWeakObjectPtr<AActor>, TArray<FAuraBatchedProjectileSpawn>> PendingSpawns;
+
+	// Struct of arrays, one entry per live projectile.
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<float> Radii;
+	TArray<float> RemainingLifeSpans;
+	// Flight time left until WallHits, FLT_MAX when the path is clear.
+	TArray<float> RemainingWallTimes;
+	TArray<FHitResult> WallHits;
+	TArray<TWeakObjectPtr<AActor>> Causers;
+	TArray<FGameplayEffectSpecHandle> DamageEffectSpecHandles;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UClass>> ProjectileClasses;
+
+	// Pawn broadphase, rebuilt every tick. Cells hold indices into PawnBounds/PawnActors.
+	TMap<FIntVector, TArray<int32>> PawnGridCells;
+	TArray<FBox> PawnBounds;
+	TArray<const AActor*> PawnActors;
+
+	// One Niagara component per projectile class, fed with every position of that class.
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, TObjectPtr<UNiagaraComponent>> VisualComponents;
+
+	TMap<UClass*, TArray<FVector>> VisualPositions;
+};
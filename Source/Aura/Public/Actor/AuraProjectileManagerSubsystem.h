@@ -0,0 +1,34 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraProjectileManagerSubsystem.generated.h"
+
+class AAuraProjectileManager;
+
+/*
+ * Owns the world's AAuraProjectileManager. The server spawns it on first use, clients get it through replication.
+ */
+UCLASS()
+class AURA_API UAuraProjectileManagerSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Server spawns the manager if needed. On clients returns null until the manager has replicated. */
+	AAuraProjectileManager* GetProjectileManager();
+
+	void RegisterProjectileManager(AAuraProjectileManager* InProjectileManager);
+	void UnregisterProjectileManager(AAuraProjectileManager* InProjectileManager);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+
+	UPROPERTY()
+	TObjectPtr<AAuraProjectileManager> ProjectileManager;
+};
@@ -0,0 +1,59 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraProjectilePoolSubsystem.generated.h"
+
+class AAuraProjectile;
+
+USTRUCT()
+struct FAuraProjectilePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AAuraProjectile>> InactiveProjectiles;
+
+	// Active plus inactive projectiles owned by this pool.
+	int32 NumSpawned = 0;
+};
+
+/*
+ * Server side pool of AAuraProjectile per class. Projectiles are spawned once and then activated/deactivated through
+ * replicated state, so casting and hitting don't spawn or destroy actors.
+ */
+UCLASS()
+class AURA_API UAuraProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/** Spawns inactive projectiles until the pool of ProjectileClass holds at least Count of them. */
+	void Prewarm(TSubclassOf<AAuraProjectile> ProjectileClass, int32 Count);
+
+	/**
+	 * Returns an inactive projectile, reusing a pooled one when available.
+	 * Like SpawnActorDeferred, set it up and then call AAuraProjectile::ActivatePooled to launch it.
+	 */
+	AAuraProjectile* AcquireProjectile(TSubclassOf<AAuraProjectile> ProjectileClass, AActor* Owner, APawn* Instigator);
+
+	void ReleaseProjectile(AAuraProjectile* Projectile);
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+
+	AAuraProjectile* SpawnPooledProjectile(TSubclassOf<AAuraProjectile> ProjectileClass, FAuraProjectilePool& Pool);
+
+	UFUNCTION()
+	void OnPooledProjectileDestroyed(AActor* DestroyedActor);
+
+	UPROPERTY()
+	TMap<TSubclassOf<AAuraProjectile>, FAuraProjectilePool> Pools;
+};
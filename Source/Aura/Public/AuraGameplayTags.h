@@ -3,6 +3,60 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 
+/*
+* Native tag table: X(Member, TagName, DevComment)
+* Generates the named members of FAuraGameplayTags, the dense EAuraGameplayTag index and the registration loop.
+*/
+#define AURA_NATIVE_GAMEPLAY_TAGS(X) \
+	X(Attribute_Primary_Strength, "Attributes.Primary.Strength", "Increases physical damage") \
+	X(Attribute_Primary_Intelligence, "Attributes.Primary.Intelligence", "Increases magical damage") \
+	X(Attribute_Primary_Resilience, "Attributes.Primary.Resilience", "Increases armor an armor penetration") \
+	X(Attribute_Primary_Vigor, "Attributes.Primary.Vigor", "Increases health") \
+	X(Attribute_Secondary_Armor, "Attributes.Secondary.Armor", "Reduces damage taken, improves Block Chance") \
+	X(Attribute_Secondary_ArmorPenetration, "Attributes.Secondary.ArmorPenetration", "ignores percentage of enemy armor, increases crit hit chance") \
+	X(Attribute_Secondary_BlockChance, "Attributes.Secondary.BlockChance", "chance to cut incoming damage in half") \
+	X(Attribute_Secondary_CriticalHitChance, "Attributes.Secondary.CriticalHitChance", "chance to double damage plus critical hit bonus") \
+	X(Attribute_Secondary_CriticalHitDamage, "Attributes.Secondary.CriticalHitDamage", "bonus damage added when a critical hit is scored") \
+	X(Attribute_Secondary_CriticalHitResistance, "Attributes.Secondary.CriticalHitResistance", "reduces critical hit chance of attacking enemies") \
+	X(Attribute_Secondary_HealthRegeneration, "Attributes.Secondary.HealthRegeneration", "amount of health regenerated every on second") \
+	X(Attribute_Secondary_ManaRegeneration, "Attributes.Secondary.ManaRegeneration", "amount of mana regenerated every on second") \
+	X(Attribute_Secondary_MaxHealth, "Attributes.Secondary.MaxHealth", "maximum amount of health obtainable") \
+	X(Attribute_Secondary_MaxMana, "Attributes.Secondary.MaxMana", "maximum amount of mana obtainable") \
+	X(Attribute_Resistance_Fire, "Attributes.Resistance.Fire", "Fire Resistance Type") \
+	X(Attribute_Resistance_Lightning, "Attributes.Resistance.Lightning", "Lightning Resistance Type") \
+	X(Attribute_Resistance_Arcane, "Attributes.Resistance.Arcane", "Arcane Resistance Type") \
+	X(Attribute_Resistance_Physical, "Attributes.Resistance.Physical", "Physical Resistance Type") \
+	X(InputTag_LMB, "InputTag_LMB", "input tag for left mouse button ") \
+	X(InputTag_RMB, "InputTag_RMB", "input tag for right mouse button ") \
+	X(InputTag_1, "InputTag_1", "input tag for number 1 ") \
+	X(InputTag_2, "InputTag_2", "input tag for number 2") \
+	X(InputTag_3, "InputTag_3", "input tag for number 3") \
+	X(InputTag_4, "InputTag_4", "input tag for number 4") \
+	X(Damage, "Damage", "Damage") \
+	X(Damage_Fire, "Damage.Fire", "Fire Damage Type") \
+	X(Damage_Lightning, "Damage.Lightning", "Lightning Damage Type") \
+	X(Damage_Arcane, "Damage.Arcane", "Arcane Damage Type") \
+	X(Damage_Physical, "Damage.Physical", "Physical Damage Type") \
+	X(Abilities_Attack, "Abilities.Attack", "Attack ability") \
+	X(Effects_HitReact, "Effects.HitReact", "react to damage")
+
+/* Damage types and the resistance that mitigates them: X(DamageTypeMember, ResistanceMember) */
+#define AURA_DAMAGE_TYPES(X) \
+	X(Damage_Arcane, Attribute_Resistance_Arcane) \
+	X(Damage_Fire, Attribute_Resistance_Fire) \
+	X(Damage_Lightning, Attribute_Resistance_Lightning) \
+	X(Damage_Physical, Attribute_Resistance_Physical)
+
+/** Dense index of every native tag, in AURA_NATIVE_GAMEPLAY_TAGS order. */
+enum class EAuraGameplayTag : uint8
+{
+#define AURA_NATIVE_TAG_ENUM(Member, TagName, DevComment) Member,
+	AURA_NATIVE_GAMEPLAY_TAGS(AURA_NATIVE_TAG_ENUM)
+#undef AURA_NATIVE_TAG_ENUM
+	Count,
+	None = Count
+};
+
 /*
 * AUragameplayTags
 * 
@@ -16,6 +70,9 @@ private:
 
 	static FAuraGameplayTags GameplayTags;
 
+	// Only for tags that arrive at runtime, native code should use the enum or the members directly.
+	TMap<FGameplayTag, EAuraGameplayTag> NativeTagIndex;
+
 protected:
 
 public:
@@ -24,44 +81,29 @@ public:
 
 	static void InitializeNativeGameplayTags();
 
-	FGameplayTag Attribute_Primary_Strength;
-	FGameplayTag Attribute_Primary_Intelligence;
-	FGameplayTag Attribute_Primary_Resilience;
-	FGameplayTag Attribute_Primary_Vigor;
-
-	FGameplayTag Attribute_Secondary_Armor;
-	FGameplayTag Attribute_Secondary_ArmorPenetration;
-	FGameplayTag Attribute_Secondary_BlockChance;
-	FGameplayTag Attribute_Secondary_CriticalHitChance;
-	FGameplayTag Attribute_Secondary_CriticalHitDamage;
-	FGameplayTag Attribute_Secondary_CriticalHitResistance;
-	FGameplayTag Attribute_Secondary_HealthRegeneration;
-	FGameplayTag Attribute_Secondary_ManaRegeneration;
-	FGameplayTag Attribute_Secondary_MaxHealth;
-	FGameplayTag Attribute_Secondary_MaxMana;
-
-	FGameplayTag Attribute_Resistance_Fire;
-	FGameplayTag Attribute_Resistance_Lightning;
-	FGameplayTag Attribute_Resistance_Arcane;
-	FGameplayTag Attribute_Resistance_Physical;
-
-	FGameplayTag InputTag_LMB;
-	FGameplayTag InputTag_RMB;
-	FGameplayTag InputTag_1;
-	FGameplayTag InputTag_2;
-	FGameplayTag InputTag_3;
-	FGameplayTag InputTag_4;
-
-	FGameplayTag Damage;
-	FGameplayTag Damage_Fire;
-	FGameplayTag Damage_Lightning;
-	FGameplayTag Damage_Arcane;
-	FGameplayTag Damage_Physical;
-
-	FGameplayTag Abilities_Attack;
-	
-	TMap<FGameplayTag, FGameplayTag> DamageTypesToResistances;
-	
-	
-	FGameplayTag Effects_HitReact;
-};
\ No newline at end of file
+	/** O(1) access by dense index. EmptyTag for None. */
+	const FGameplayTag& GetTag(EAuraGameplayTag Tag) const;
+
+	/** Dense index of Tag, None when it isn't a native tag. */
+	EAuraGameplayTag FindNativeTag(const FGameplayTag& Tag) const;
+
+#define AURA_NATIVE_TAG_MEMBER(Member, TagName, DevComment) FGameplayTag Member;
+	AURA_NATIVE_GAMEPLAY_TAGS(AURA_NATIVE_TAG_MEMBER)
+#undef AURA_NATIVE_TAG_MEMBER
+
+	// Contiguous, in AURA_DAMAGE_TYPES order.
+	TArray<TPair<FGameplayTag, FGameplayTag>> DamageTypesToResistances;
+};
+
+inline const FGameplayTag& FAuraGameplayTags::GetTag(EAuraGameplayTag Tag) const
+{
+	static constexpr FGameplayTag FAuraGameplayTags::* Members[] =
+	{
+#define AURA_NATIVE_TAG_POINTER(Member, TagName, DevComment) &FAuraGameplayTags::Member,
+		AURA_NATIVE_GAMEPLAY_TAGS(AURA_NATIVE_TAG_POINTER)
+#undef AURA_NATIVE_TAG_POINTER
+	};
+	// None == Count, what FindNativeTag returns for tags that aren't native
+	if (Tag >= EAuraGameplayTag::Count) return FGameplayTag::EmptyTag;
+	return this->*Members[static_cast<int32>(Tag)];
+}
@@ -11,6 +11,7 @@
 class UWidgetComponent;
 class UBehaviorTree;
 class AAuraAIController;
+enum class EAuraSignificanceBucket : uint8;
 
 UCLASS()
 class AURA_API AAuraEnemy : public AAuraCharacterBase, public IEnemyInterface
@@ -28,13 +29,20 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	TObjectPtr<UWidgetComponent> HealthBar;
 
+	// Draw the health bar in the HUD's shared layer (UAuraHealthBarLayer) instead of the HealthBar widget component,
+	// which is destroyed. The component placement is still used as the bar offset. Opt in per enemy Blueprint.
+	UPROPERTY(EditDefaultsOnly, Category = "UI")
+	bool bUseSharedHealthBar = false;
+
 	UPROPERTY(EditAnywhere, Category="AI")
 	TObjectPtr<UBehaviorTree> BehaviorTree;
 
 	UPROPERTY()
 	TObjectPtr<AAuraAIController> AuraAIController;
 
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void InitAbilityActorInfo() override;
 	virtual void InitilizeDefaultAttributes() const override;
 
@@ -73,4 +81,25 @@ public:
 
 	void HitReactTagChange(const FGameplayTag CallbackTag, int32 NewCount);
 
+	/** Called by UAuraSignificanceSubsystem when the enemy changes bucket or goes on/off screen. */
+	void ApplySignificance(EAuraSignificanceBucket Bucket, bool bVisible);
+
+	bool HasAppliedSignificance() const { return bSignificanceApplied; }
+
+private:
+
+	float DefaultNetUpdateFrequency = 0.f;
+
+	// False until the first ApplySignificance, the manager's initial significance may already match the first bucket.
+	bool bSignificanceApplied = false;
+
+	FVector SharedHealthBarOffset = FVector::ZeroVector;
+	int32 SharedHealthBarHandle = INDEX_NONE;
+
+	UFUNCTION()
+	void SetSharedHealthBarHealth(float NewValue);
+
+	UFUNCTION()
+	void SetSharedHealthBarMaxHealth(float NewValue);
+
 };
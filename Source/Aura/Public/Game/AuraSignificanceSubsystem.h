@@ -0,0 +1,70 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraSignificanceSubsystem.generated.h"
+
+class AAuraEnemy;
+
+/** Distance buckets, most significant first. */
+enum class EAuraSignificanceBucket : uint8
+{
+	High,
+	Medium,
+	Low,
+	Dormant,
+	Count
+};
+
+/** What an enemy in a given bucket is allowed to spend. */
+struct FAuraSignificanceSettings
+{
+	// 0 ticks every frame.
+	float MovementTickInterval = 0.f;
+
+	// The behavior tree schedules its own ticks, so it is only paused outright, never slowed down.
+	bool bPauseBehaviorTree = false;
+
+	// Scales the enemy's default NetUpdateFrequency.
+	float NetUpdateFrequencyScale = 1.f;
+
+	bool bShowHealthBar = true;
+};
+
+/*
+ * Feeds the SignificanceManager with the player viewpoints every tick and buckets the registered enemies by distance.
+ * The server uses the buckets for AI, movement and net update rates, clients for movement and health bars
+ * (hidden while the enemy is off-screen).
+ */
+UCLASS()
+class AURA_API UAuraSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	void RegisterEnemy(AAuraEnemy* Enemy);
+	void UnregisterEnemy(AAuraEnemy* Enemy);
+
+	static const FAuraSignificanceSettings& GetSettings(EAuraSignificanceBucket Bucket);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+
+	void GatherViewpoints();
+	EAuraSignificanceBucket GetBucketForDistanceSquared(float DistanceSquared) const;
+
+	TArray<FTransform> Viewpoints;
+
+	// Bucket thresholds, read from the cvars once per Tick before the manager updates.
+	float MediumDistanceSquared = 0.f;
+	float LowDistanceSquared = 0.f;
+	float DormantDistanceSquared = 0.f;
+};
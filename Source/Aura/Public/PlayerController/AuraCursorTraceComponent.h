@@ -0,0 +1,68 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldCollision.h"
+#include "AuraCursorTraceComponent.generated.h"
+
+/*
+ * Cursor trace for the owning player controller. Re-traces only when the mouse or camera moved past a threshold or
+ * MaxTraceInterval elapsed, and keeps the last hit for everyone that needs what's under the cursor.
+ */
+UCLASS(ClassGroup = (Aura), meta = (BlueprintSpawnableComponent))
+class AURA_API UAuraCursorTraceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UAuraCursorTraceComponent();
+
+	/** Called every tick by the owning controller. Returns true when CursorHit changed since the last call. */
+	bool UpdateCursorHit(float DeltaTime);
+
+	const FHitResult& GetCursorHit() const { return CursorHit; }
+
+protected:
+
+	UPROPERTY(EditDefaultsOnly, Category = "Cursor Trace")
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
+	/** Re-trace at least this often (seconds) so actors moving under a still cursor are picked up. */
+	UPROPERTY(EditDefaultsOnly, Category = "Cursor Trace", meta = (ClampMin = 0))
+	float MaxTraceInterval = 0.1f;
+
+	/** Mouse movement in pixels that forces a re-trace. */
+	UPROPERTY(EditDefaultsOnly, Category = "Cursor Trace", meta = (ClampMin = 0))
+	float MouseMoveThreshold = 2.f;
+
+	/** Camera movement in cm that forces a re-trace. */
+	UPROPERTY(EditDefaultsOnly, Category = "Cursor Trace", meta = (ClampMin = 0))
+	float CameraMoveThreshold = 5.f;
+
+	/** Camera rotation in degrees that forces a re-trace. */
+	UPROPERTY(EditDefaultsOnly, Category = "Cursor Trace", meta = (ClampMin = 0))
+	float CameraRotationThreshold = 0.5f;
+
+	/** Runs the trace through the async trace API. The hit arrives one frame later but stays off the game thread. */
+	UPROPERTY(EditDefaultsOnly, Category = "Cursor Trace")
+	bool bUseAsyncTrace = false;
+
+private:
+
+	bool ShouldTrace(const FVector2D& MousePosition, const FVector& CameraLocation, const FRotator& CameraRotation) const;
+	void OnAsyncTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	FHitResult CursorHit;
+	bool bCursorHitChanged = false;
+
+	float TimeSinceTrace = 0.f;
+	bool bHasTraced = false;
+	FVector2D LastMousePosition = FVector2D::ZeroVector;
+	FVector LastCameraLocation = FVector::ZeroVector;
+	FRotator LastCameraRotation = FRotator::ZeroRotator;
+
+	FTraceHandle PendingTraceHandle;
+	FTraceDelegate AsyncTraceDelegate;
+};
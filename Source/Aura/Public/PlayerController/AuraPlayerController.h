@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
 #include "GameplayTagContainer.h"
+#include "AI/Navigation/NavigationTypes.h"
 #include "AuraPlayerController.generated.h"
 
 class UDamageTextComponent;
@@ -14,6 +15,38 @@ class IEnemyInterface;
 class UAuraInputConfig;
 class UAuraAbilitySystemComponent;
 class USplineComponent;
+class UAuraCursorTraceComponent;
+class UDamageTextPoolComponent;
+
+/** One damage number sent to the client: target net GUID, amount rounded to uint16 and two flag bits. */
+USTRUCT()
+struct FAuraDamageNumber
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<ACharacter> TargetCharacter = nullptr;
+
+	UPROPERTY()
+	float DamageAmount = 0.f;
+
+	UPROPERTY()
+	bool bIsBlockedHit = false;
+
+	UPROPERTY()
+	bool bIsCriticalHit = false;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FAuraDamageNumber> : public TStructOpsTypeTraitsBase2<FAuraDamageNumber>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
 
 UCLASS()
 class AURA_API AAuraPlayerController : public APlayerController
@@ -25,9 +58,13 @@ public:
 	AAuraPlayerController();
 	virtual void PlayerTick(float DeltaTime) override;
 
-	UFUNCTION(Client,Reliable)
+	/** Server side. Damage numbers are batched and sent to the client once per frame. */
 	void ShowDamageNumber(float DamageAmount, ACharacter* TargetCharacter, bool bIsBlockedHit, bool bIsCriticalHit);
 
+	// Cosmetic only, so unreliable: a dropped batch just loses some numbers.
+	UFUNCTION(Client, Unreliable)
+	void ClientShowDamageNumbers(const TArray<FAuraDamageNumber>& DamageNumbers);
+
 protected:
 
 	virtual void BeginPlay() override;
@@ -54,11 +91,14 @@ private:
 	TSubclassOf<UDamageTextComponent> DamageComponentTextClass;
 
 	void Move(const FInputActionValue& InputActionValue);
-	void CursorTrace();
+	void CursorTrace(float DeltaTime);
 	void AbilityInputTagPressed(FGameplayTag InputTag);
 	void AbilityInputTagReleased(FGameplayTag InputTag);
 	void AbilityInputTagHeld(FGameplayTag InputTag);
 	void AutoRun();
+	void RequestClickToMovePath(const APawn* ControlledPawn);
+	void OnClickToMovePathFound(uint32 PathId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	void SetAutoRunPath(const TArray<FVector>& PathPoints);
 	void ShiftPressed() { bShiftKeyDown = true; }
 	void ShiftReleased(){ bShiftKeyDown = false; }
 
@@ -74,9 +114,29 @@ private:
 	float ShortPressThreshold = 0.5f;
 	bool bAutoRunning = false;
 	bool bTargeting = false;
-	FHitResult CursorHit;
+	uint32 ClickToMovePathId = INVALID_NAVQUERYID;
+	double ClickToMovePathRequestTime = 0.0;
 	UPROPERTY(EditDefaultsOnly)
 	float AutoRunAcceptanceRadius = 50.f;
+	/** Distance from the current path segment that triggers a new path request while auto-running. */
+	UPROPERTY(EditDefaultsOnly)
+	float AutoRunRepathDistance = 200.f;
+	// Auto-run path and the segment being followed, only moves forward.
+	TArray<FVector> AutoRunPathPoints;
+	int32 AutoRunSegmentIndex = 0;
 	UPROPERTY(VisibleAnywhere)
 	TObjectPtr<USplineComponent> Spline;
+
+	UPROPERTY(VisibleAnywhere)
+	TObjectPtr<UAuraCursorTraceComponent> CursorTraceComponent;
+
+	UPROPERTY(VisibleAnywhere)
+	TObjectPtr<UDamageTextPoolComponent> DamageTextPool;
+
+	void FlushDamageNumbers();
+
+	UPROPERTY()
+	TArray<FAuraDamageNumber> PendingDamageNumbers;
+
+	FTimerHandle FlushDamageNumbersTimer;
 };
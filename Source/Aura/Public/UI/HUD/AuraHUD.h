@@ -11,6 +11,7 @@ struct FWidgetControllerParams;
 class UAbilitySystemComponent;
 class UAttributeSet;
 class UAttributeMenuWidgetController;
+class UAuraHealthBarLayer;
 
 UCLASS()
 class AURA_API AAuraHUD : public AHUD
@@ -38,10 +39,21 @@ private:
 	UPROPERTY(EditAnywhere)
 	TSubclassOf<UAttributeMenuWidgetController> AttributeMenuWidgetControllerClass;
 
+	UPROPERTY()
+	TObjectPtr<UAuraHealthBarLayer> HealthBarLayer;
+
+	// Draws the enemy health bars of UAuraHealthBarSubsystem, under the overlay.
+	UPROPERTY(EditAnywhere)
+	TSubclassOf<UAuraHealthBarLayer> HealthBarLayerClass;
+
+protected:
+
+	virtual void BeginPlay() override;
 
 
 public:
 
+	AAuraHUD();
 
 	UOverlayWidgetController* GetOverlayWidgetController(const FWidgetControllerParams& WCParams);
 
@@ -0,0 +1,50 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraHealthBarSubsystem.generated.h"
+
+struct FAuraHealthBarEntry
+{
+	TWeakObjectPtr<const AActor> Owner;
+
+	// World space offset from the owner's location to the bar.
+	FVector Offset = FVector::ZeroVector;
+
+	float Health = 0.f;
+	float MaxHealth = 0.f;
+	bool bVisible = true;
+
+	float GetHealthRatio() const { return MaxHealth > 0.f ? FMath::Clamp(Health / MaxHealth, 0.f, 1.f) : 0.f; }
+};
+
+/*
+ * Health bar data for every enemy in the world, drawn in one pass by UAuraHealthBarLayer
+ * instead of one UWidgetComponent per enemy. Only used on clients and listen servers.
+ */
+UCLASS()
+class AURA_API UAuraHealthBarSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns a handle for the other calls, INDEX_NONE on dedicated servers. */
+	int32 RegisterHealthBar(const AActor* Owner, const FVector& Offset);
+	void UnregisterHealthBar(int32 Handle);
+
+	void SetHealth(int32 Handle, float Health);
+	void SetMaxHealth(int32 Handle, float MaxHealth);
+	void SetHealthBarVisible(int32 Handle, bool bVisible);
+
+	const TSparseArray<FAuraHealthBarEntry>& GetEntries() const { return Entries; }
+
+protected:
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+
+	TSparseArray<FAuraHealthBarEntry> Entries;
+};
@@ -0,0 +1,50 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Styling/SlateBrush.h"
+#include "AuraHealthBarLayer.generated.h"
+
+/*
+ * Full screen layer that paints every visible enemy health bar as two boxes in NativePaint,
+ * so the UI cost is one widget no matter how many enemies are alive.
+ */
+UCLASS()
+class AURA_API UAuraHealthBarLayer : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+
+	UPROPERTY(EditAnywhere, Category = "Health Bar")
+	FVector2D BarSize = FVector2D(80.f, 8.f);
+
+	UPROPERTY(EditAnywhere, Category = "Health Bar")
+	FSlateBrush BackgroundBrush;
+
+	UPROPERTY(EditAnywhere, Category = "Health Bar")
+	FSlateBrush FillBrush;
+
+	UPROPERTY(EditAnywhere, Category = "Health Bar")
+	FLinearColor BackgroundColor = FLinearColor(0.f, 0.f, 0.f, 0.6f);
+
+	UPROPERTY(EditAnywhere, Category = "Health Bar")
+	FLinearColor FillColor = FLinearColor(0.8f, 0.05f, 0.05f, 1.f);
+
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+private:
+
+	struct FDrawItem
+	{
+		FVector2D Position;
+		float HealthRatio;
+	};
+
+	// Rebuilt every tick from UAuraHealthBarSubsystem, only bars in front of the camera.
+	TArray<FDrawItem> DrawItems;
+};
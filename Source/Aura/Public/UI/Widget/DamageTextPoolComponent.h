@@ -0,0 +1,73 @@
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "DamageTextPoolComponent.generated.h"
+
+class UDamageTextComponent;
+
+/*
+ * Floating damage numbers for the local player. Reuses UDamageTextComponent instances instead of creating one per hit,
+ * caps how many are on screen and folds hits on the same target within AggregationWindow into one number.
+ */
+UCLASS(ClassGroup = (Aura), meta = (BlueprintSpawnableComponent))
+class AURA_API UDamageTextPoolComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UDamageTextPoolComponent();
+
+	void ShowDamageText(TSubclassOf<UDamageTextComponent> DamageTextClass, ACharacter* TargetCharacter, float DamageAmount, bool bIsBlockedHit, bool bIsCriticalHit);
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Seconds a number stays up before going back to the pool. */
+	UPROPERTY(EditDefaultsOnly, Category = "Damage Text", meta = (ClampMin = 0))
+	float DamageTextLifetime = 1.f;
+
+	/** Oldest number is recycled when this many are visible. */
+	UPROPERTY(EditDefaultsOnly, Category = "Damage Text", meta = (ClampMin = 1))
+	int32 MaxVisibleDamageTexts = 24;
+
+	/** Hits on a target within this many seconds of its last number are added to it. 0 disables aggregation. */
+	UPROPERTY(EditDefaultsOnly, Category = "Damage Text", meta = (ClampMin = 0))
+	float AggregationWindow = 0.15f;
+
+private:
+
+	struct FActiveDamageText
+	{
+		TObjectPtr<UDamageTextComponent> Component;
+		TWeakObjectPtr<ACharacter> Target;
+		double ShowTime = 0.0;
+		float DamageAmount = 0.f;
+		bool bIsBlockedHit = false;
+		bool bIsCriticalHit = false;
+	};
+
+	UDamageTextComponent* AcquireDamageText(TSubclassOf<UDamageTextComponent> DamageTextClass);
+	void ReleaseDamageText(UDamageTextComponent* DamageText);
+
+	/** Actor the pooled components are registered on, spawned on first use. */
+	AActor* GetHostActor();
+
+	// Oldest first. HostActor keeps the components alive, they are registered on it.
+	TArray<FActiveDamageText> ActiveDamageTexts;
+
+	// Widget components don't show while their owner is hidden, and controllers always are.
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> HostActor;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UDamageTextComponent>> InactiveDamageTexts;
+
+	UPROPERTY(Transient)
+	TSubclassOf<UDamageTextComponent> PooledClass;
+};
@@ -3,10 +3,10 @@
 
 #include "CoreMinimal.h"
 #include "UI/WidgetController/AuraWidgetController.h"
+#include "AbilitySystem/Data/AttributeInfoDataAsset.h"
+#include "AbilitySystem/AuraAttributeSet.h"
 #include "AttributeMenuWidgetController.generated.h"
 
-struct FAuraAttributeInfo;
-class UAttributeInfoDataAsset;
 struct FGameplayTag;
 struct FGameplayAttribute;
 
@@ -19,8 +19,10 @@ class AURA_API UAttributeMenuWidgetController : public UAuraWidgetController
 
 private:
 
-	void BroadcastAttributeInfo(const FGameplayTag& AttributeTag, const FGameplayAttribute& Attribute) const;
+	void BroadcastAttributeInfo(EAuraAttribute AuraAttribute) const;
 
+	// Info looked up once per attribute and indexed by EAuraAttribute, only AttributeValue changes between broadcasts.
+	mutable TArray<FAuraAttributeInfo> CachedAttributeInfo;
 	
 protected:
 
@@ -34,6 +36,8 @@ public:
 
 	virtual void BindCallbacksToDependencies() override;
 
+	virtual void BroadcastDirtyAttribute(const FGameplayAttribute& Attribute, float NewValue) override;
+
 	UPROPERTY(BlueprintAssignable, Category = "GAS|Attributes")
 	FAttributeInfoSignature FAttributeInfoDelegate;
 
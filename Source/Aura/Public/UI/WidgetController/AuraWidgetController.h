@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "AttributeSet.h"
 #include "AuraWidgetController.generated.h"
 
 class UAbilitySystemComponent;
@@ -51,6 +52,23 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "WidgetController")
 	TObjectPtr<UAttributeSet> AttributeSet;
 
+	/** Seconds between attribute broadcasts to widgets. 0 sends one consolidated update on the next tick. */
+	UPROPERTY(EditDefaultsOnly, Category = "WidgetController", meta = (ClampMin = 0))
+	float AttributeBroadcastInterval = 0.f;
+
+	/** Queues Attribute for the next flush instead of broadcasting every change straight to the widgets. */
+	void MarkAttributeDirty(const FGameplayAttribute& Attribute);
+
+	/** Called once per dirty attribute on flush, with its current value. */
+	virtual void BroadcastDirtyAttribute(const FGameplayAttribute& Attribute, float NewValue);
+
+private:
+
+	void FlushDirtyAttributes();
+
+	TArray<FGameplayAttribute> DirtyAttributes;
+	FTimerHandle FlushDirtyAttributesTimer;
+
 public:
 
 	UFUNCTION(BlueprintCallable)
@@ -45,6 +45,18 @@ protected:
 	template<typename T> 
 	T* GetDataTableRowByTag(UDataTable* DataTable, const FGameplayTag& Tag);
 
+	/** Rebuilds MessageRoutes from MessageWidgetDataTable. Also called whenever the table changes. */
+	void BuildMessageRoutes();
+
+	void BroadcastMessages(const FGameplayTagContainer& AssetTags) const;
+
+private:
+
+	// Message.* tag to its widget row, so routing a message is a single map lookup.
+	TMap<FGameplayTag, FUIWidgetRow> MessageRoutes;
+
+	FDelegateHandle MessageTableChangedHandle;
+
 public:
 
 	virtual void BroadcastInitialvalues() override;
@@ -64,6 +76,10 @@ public:
 
 	UPROPERTY(BlueprintAssignable, Category = "GAS | Messages")
 	FMessageWidgetRowSignature MessageWidgetRow;
+
+protected:
+
+	virtual void BroadcastDirtyAttribute(const FGameplayAttribute& Attribute, float NewValue) override;
 };
 
 template<typename T>
@@ -10,6 +10,9 @@ public class AuraEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 
+		// UAuraAttributeSet and AAuraProjectileManager replicate push based
+		bWithPushModel = true;
+
 		ExtraModuleNames.AddRange( new string[] { "Aura" } );
 	}
 }